@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+
+// Define AOC_TRACK_ALLOCATIONS=1 in the project settings to replace the global operator new
+// and operator delete with versions that count what each test allocates. It is off by
+// default because every allocation pays for the bookkeeping.
+#ifndef AOC_TRACK_ALLOCATIONS
+#define AOC_TRACK_ALLOCATIONS 0
+#endif
+
+namespace advent
+{
+	constexpr bool allocation_tracking_enabled = AOC_TRACK_ALLOCATIONS != 0;
+
+	// Heap use between a start_allocation_tracking() and stop_allocation_tracking() on one thread.
+	// Memory allocated by other threads (for example std::async work) is not included.
+	struct allocation_stats
+	{
+		std::size_t allocations = 0;
+		std::size_t deallocations = 0;
+		std::size_t bytes_allocated = 0;
+		// Most bytes live at once, counting only memory allocated since tracking started.
+		std::size_t peak_live_bytes = 0;
+	};
+
+	// Used by the test harness. Without AOC_TRACK_ALLOCATIONS these do nothing and the stats are all zero.
+	void start_allocation_tracking();
+	allocation_stats stop_allocation_tracking();
+}
\ No newline at end of file
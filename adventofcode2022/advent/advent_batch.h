@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <chrono>
+
+// Settings for batch mode, which solves one day's puzzle for every input in a directory as fast
+// as it can, the way many users' inputs for the same puzzle are served in production.
+struct batch_options
+{
+	int day = 0;
+
+	// 1 or 2, or 0 to solve both parts of each input from one parse (see advent::get_both_solver).
+	int part = 0;
+
+	// Every regular file in here is an input.
+	std::string input_directory;
+
+	// Stop any solve still running after this long. Zero means no limit.
+	std::chrono::milliseconds solve_timeout{ 0 };
+
+	// One JSON line per input and part with its answer and solve time. Leave blank to skip.
+	// When solving both parts, each part's time is the time for both.
+	std::string results_file;
+};
+
+// Solves the inputs in parallel on the thread pool (see utils::set_thread_count), then reports
+// inputs per second and the spread of per-input latency.
+// Returns false if any input failed or timed out.
+bool run_batch(const batch_options& options);
\ No newline at end of file
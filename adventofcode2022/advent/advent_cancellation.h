@@ -0,0 +1,74 @@
+#pragma once
+
+#include <chrono>
+#include <limits>
+
+namespace advent
+{
+	// Thrown out of a test that has run past its time budget.
+	class test_timed_out
+	{
+	};
+
+	// Tells long-running code when the test it belongs to has run out of time.
+	class cancellation_token
+	{
+		using clock = std::chrono::steady_clock;
+		clock::time_point m_deadline = clock::time_point::max();
+	public:
+		// A token that is never cancelled.
+		cancellation_token() noexcept = default;
+		explicit cancellation_token(clock::time_point deadline) noexcept : m_deadline{ deadline } {}
+
+		bool has_deadline() const noexcept { return m_deadline != clock::time_point::max(); }
+		bool is_cancelled() const noexcept { return has_deadline() && clock::now() >= m_deadline; }
+		void check() const
+		{
+			if (is_cancelled()) [[unlikely]]
+			{
+				throw test_timed_out{};
+			}
+		}
+	};
+
+	// The token for the test running on this thread.
+	cancellation_token get_cancellation_token() noexcept;
+
+	// Makes token the current one for this thread until destroyed. The harness uses this to give
+	// each test its budget, and days that hand work to other threads use it to pass that budget on.
+	class cancellation_scope
+	{
+		cancellation_token m_previous;
+	public:
+		explicit cancellation_scope(cancellation_token token) noexcept;
+		cancellation_scope(const cancellation_scope&) = delete;
+		cancellation_scope& operator=(const cancellation_scope&) = delete;
+		~cancellation_scope() noexcept;
+	};
+
+	namespace cancellation_internal
+	{
+		// Reading the clock costs more than many of the loop bodies that check for cancellation,
+		// so with a budget the clock is only read on every clock_check_interval-th check. Without
+		// one, the countdown starts so high that it never runs out in practice.
+		constexpr unsigned int clock_check_interval = 1024;
+		inline thread_local unsigned int checks_until_clock_read = std::numeric_limits<unsigned int>::max();
+
+		// Restarts the countdown, and throws if the budget has run out.
+		void check_deadline();
+	}
+
+	// Call at the head of long loops. Throws test_timed_out once the running test is over its budget.
+	// Inline, and costs a branch and a decrement whether or not there is a budget. With a budget,
+	// only one call in 1024 reads the clock, so a loop may run on for a few more iterations after
+	// the deadline.
+	inline void check_cancellation()
+	{
+		if (cancellation_internal::checks_until_clock_read > 0) [[likely]]
+		{
+			--cancellation_internal::checks_until_clock_read;
+			return;
+		}
+		cancellation_internal::check_deadline();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace advent
+{
+	// CPU events counted while a test ran. Each is empty if the machine couldn't count it.
+	struct hardware_counters
+	{
+		std::optional<std::uint64_t> cycles;
+		std::optional<std::uint64_t> instructions;
+		std::optional<std::uint64_t> l1d_misses;
+		std::optional<std::uint64_t> llc_misses;
+		std::optional<std::uint64_t> branch_misses;
+
+		bool any() const
+		{
+			return cycles || instructions || l1d_misses || llc_misses || branch_misses;
+		}
+
+		// Instructions per cycle, if both were counted.
+		std::optional<double> ipc() const
+		{
+			if (!cycles || !instructions || *cycles == 0)
+			{
+				return std::nullopt;
+			}
+			return static_cast<double>(*instructions) / static_cast<double>(*cycles);
+		}
+	};
+
+	// Counts hardware events on the calling thread between start() and stop().
+	// Work handed to other threads, such as the thread pool's workers, is not included, so
+	// days that run in parallel (16 part 2 and 19, for example) are undercounted.
+	// This uses perf_event_open, so only counts anything on Linux, and only where the
+	// kernel lets user processes see their own counters (see perf_event_paranoid).
+	// Everywhere else, or for events the CPU doesn't have, the counts are simply left empty.
+	class counter_set
+	{
+		static constexpr std::size_t num_events = 5;
+		std::array<int, num_events> m_fds;
+	public:
+		counter_set();
+		counter_set(const counter_set&) = delete;
+		counter_set& operator=(const counter_set&) = delete;
+		~counter_set();
+
+		bool any_available() const;
+		void start();
+		hardware_counters stop();
+	};
+
+	// Why cycles can't be counted on this machine, or empty if they can.
+	std::optional<std::string_view> hardware_counters_unavailable_reason();
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <istream>
+#include <ostream>
+#include <chrono>
+#include <cstddef>
+
+// Daemon mode solves a stream of jobs in one long-running process, so the thread pool, the heap
+// and the code stay warm between inputs instead of being paid for again by a fresh process each time.
+//
+// Each job is a line of whitespace-separated fields, either
+//     <id> <day> <part> file <path>
+//     <id> <day> <part> inline <byte count>
+// where an inline job's input is the <byte count> bytes straight after the line's newline.
+// The id is any word, and is echoed back so answers can be matched to jobs. Blank lines are skipped.
+// Trailing newlines are dropped from inputs, as the solvers expect inputs without one.
+//
+// Each job gets one JSON line back, flushed as soon as the job finishes:
+//     {"id":"a1","day":20,"part":1,"status":"ok","result":"1234","time_ns":56789}
+// status is "ok", "timeout", or "error" with an "error" message in place of the result.
+struct daemon_options
+{
+	// Stop any job still running after this long. Zero means no limit.
+	std::chrono::milliseconds job_timeout{ 0 };
+};
+
+// Serves jobs until the input ends. Returns the number of jobs that didn't succeed.
+std::size_t run_daemon(std::istream& jobs, std::ostream& results, const daemon_options& options);
\ No newline at end of file
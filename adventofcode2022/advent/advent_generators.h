@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace advent
+{
+	constexpr int first_generated_day = 1;
+	constexpr int last_generated_day = 25;
+
+	// Makes a valid input for a day's puzzle, with scale setting how big it is (see describe_input_scale).
+	// The same day, scale and seed always give the same input on every platform, so generated inputs
+	// can stand in for the real ones when benchmarking at sizes the puzzle files don't reach.
+	// Inputs don't end in a newline, like the testcase files.
+	std::string generate_input(int day, std::size_t scale, std::uint64_t seed = 0);
+
+	// What scale counts for a day's generator, e.g. "elves" for day 1.
+	std::string_view describe_input_scale(int day);
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <optional>
+#include <vector>
+
+namespace advent
+{
+	// What a benchmark ran on, so timings from different machines can be told apart.
+	// Anything the platform doesn't report is left empty.
+	struct host_info
+	{
+		std::string cpu_model;
+		unsigned int logical_cores = 0;
+
+		// The CPU frequency governor on Linux (e.g. "performance"), or the power plan on Windows.
+		std::string governor;
+
+		// Whether the CPU may boost above its base clock, if known.
+		std::optional<bool> turbo_enabled;
+
+		// Average number of runnable processes over the last minute when the run started.
+		std::optional<double> load_average;
+
+		// How the benchmark thread was isolated (see thread_isolation).
+		std::optional<int> pinned_core;
+		bool raised_priority = false;
+	};
+
+	// Reads the current state of the machine. core is the one to read the governor of,
+	// as it can differ between cores.
+	host_info get_host_info(int core = 0);
+
+	// While alive, keeps the calling thread on one logical core and/or at a raised scheduling
+	// priority, so benchmarks aren't disturbed by the scheduler moving the thread or running other
+	// work ahead of it. Each setting that can't be applied is left alone; check with pinned()
+	// and raised_priority(). Raising priority usually needs administrator or root rights.
+	// The thread's previous settings are restored on destruction.
+	class thread_isolation
+	{
+		int m_core = -1;
+		bool m_pinned = false;
+		bool m_raised_priority = false;
+#if defined(_WIN32)
+		unsigned long long m_previous_affinity = 0;
+		int m_previous_priority = 0;
+		unsigned long m_previous_priority_class = 0;
+		// Priority is raised in two steps, and each one that took is undone on its own.
+		bool m_raised_priority_class = false;
+		bool m_raised_thread_priority = false;
+#else
+		std::vector<int> m_previous_cores;
+		int m_previous_nice = 0;
+#endif
+	public:
+		// A negative core leaves the thread free to run anywhere.
+		thread_isolation(int core, bool raise_priority);
+		thread_isolation(const thread_isolation&) = delete;
+		thread_isolation& operator=(const thread_isolation&) = delete;
+		~thread_isolation();
+
+		bool pinned() const { return m_pinned; }
+		bool raised_priority() const { return m_raised_priority; }
+		int core() const { return m_core; }
+	};
+}
\ No newline at end of file
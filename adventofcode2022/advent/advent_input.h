@@ -0,0 +1,159 @@
+#pragma once
+
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+
+namespace advent
+{
+	// Puzzle inputs are mapped into memory once and kept for the life of the program, so every
+	// test that uses an input after the first sees it already in memory. The views these
+	// return stay valid until the program exits, so days can parse them without copying.
+	// Inputs with Windows line endings have them turned into plain newlines when loaded, which is
+	// what the days' parsers expect; only those inputs are copied rather than mapped.
+	std::string_view get_puzzle_input(int day);
+	std::string_view get_testcase_input(int day, char id);
+
+	// text with every "\r\n" turned into "\n". Lone carriage returns are kept.
+	std::string normalise_line_endings(std::string_view text);
+
+	// Passes another stream buffer's characters through as they arrive, except that any newlines
+	// at the very end are dropped, as the solvers expect inputs without one, and line endings are
+	// normalised as they are for files. Only as many newlines as are waiting to see if anything
+	// follows them are held back.
+	class trimmed_streambuf : public std::streambuf
+	{
+		std::streambuf* m_source;
+		std::vector<char> m_buffer;
+		std::string m_held_newlines;
+	public:
+		explicit trimmed_streambuf(std::streambuf& source) : m_source{ &source } {}
+	protected:
+		int_type underflow() override;
+	};
+
+	// While alive, get_puzzle_input(day) on this thread returns text instead of the file, so a day's
+	// solver can be run on other inputs (such as generated ones) unchanged. text must outlive this.
+	// Line endings are normalised as they are for files.
+	//
+	// Alternatively the input can come from a stream such as stdin, which must also outlive this.
+	// open_puzzle_input(day) then reads from the stream as the input arrives, rather than waiting
+	// for all of it, and get_puzzle_input(day) reads all of it into memory first. A stream can
+	// only be read once, so only one of these can be used, and only once.
+	class puzzle_input_override
+	{
+		enum class stream_state : char
+		{
+			none,
+			unread,
+			streamed,
+			buffered
+		};
+
+		const puzzle_input_override* m_previous;
+		int m_day;
+		std::string_view m_text;
+
+		// Set on first use, which can come through a const pointer from the override chain.
+		mutable stream_state m_stream_state = stream_state::none;
+		mutable std::optional<trimmed_streambuf> m_stream;
+		mutable std::string m_buffered_text;
+	public:
+		puzzle_input_override(int day, std::string_view text) noexcept;
+		puzzle_input_override(int day, std::istream& source) noexcept;
+		puzzle_input_override(const puzzle_input_override&) = delete;
+		puzzle_input_override& operator=(const puzzle_input_override&) = delete;
+		~puzzle_input_override() noexcept;
+
+		int get_day() const noexcept { return m_day; }
+		std::string_view get_text() const;
+
+		// The stream to read the input from, or nullptr if it is in memory.
+		std::streambuf* get_stream() const;
+
+		const puzzle_input_override* get_previous() const noexcept { return m_previous; }
+	};
+
+	// The stream buffer an override for day is reading from, or nullptr if day's input is in memory.
+	std::streambuf* get_puzzle_stream(int day);
+
+	// A read-only stream buffer over memory that outlives it.
+	class view_streambuf : public std::streambuf
+	{
+	public:
+		explicit view_streambuf(std::string_view data)
+		{
+			// The get area is never written through, so dropping const here is safe.
+			char* first = const_cast<char*>(data.data());
+			setg(first, first, first + data.size());
+		}
+	protected:
+		pos_type seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+		{
+			if ((which & std::ios_base::in) == 0)
+			{
+				return pos_type(off_type(-1));
+			}
+			off_type base = 0;
+			switch (dir)
+			{
+			case std::ios_base::beg:
+				base = 0;
+				break;
+			case std::ios_base::cur:
+				base = gptr() - eback();
+				break;
+			case std::ios_base::end:
+				base = egptr() - eback();
+				break;
+			default:
+				return pos_type(off_type(-1));
+			}
+			const off_type target = base + offset;
+			if (target < 0 || target > egptr() - eback())
+			{
+				return pos_type(off_type(-1));
+			}
+			setg(eback(), eback() + target, egptr());
+			return pos_type(target);
+		}
+
+		pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+		{
+			return seekoff(off_type(pos), std::ios_base::beg, which);
+		}
+	};
+
+	// An istream over memory that outlives it, such as a cached puzzle input,
+	// or over a stream buffer that is read as it arrives.
+	class input_stream : public std::istream
+	{
+		view_streambuf m_buffer;
+		std::string_view m_data;
+		bool m_is_streaming = false;
+	public:
+		explicit input_stream(std::string_view data) : std::istream{ nullptr }, m_buffer{ data }, m_data{ data }
+		{
+			rdbuf(&m_buffer);
+		}
+		explicit input_stream(std::streambuf& source) : std::istream{ &source }, m_buffer{ std::string_view{} }, m_is_streaming{ true }
+		{
+		}
+		input_stream(const input_stream&) = delete;
+		input_stream& operator=(const input_stream&) = delete;
+
+		// Inputs are checked when they are loaded, so by now this is always true.
+		// It is here so code written against std::ifstream keeps working.
+		bool is_open() const { return true; }
+
+		// True if the input is arriving as it is read, so there is no view of all of it.
+		bool is_streaming() const { return m_is_streaming; }
+
+		// The whole input, regardless of how much has been read from the stream.
+		// Empty when streaming.
+		std::string_view view() const { return m_data; }
+	};
+}
\ No newline at end of file
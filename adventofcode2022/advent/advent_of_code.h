@@ -1,6 +1,73 @@
 #pragma once
 
 #include <string>
+#include <chrono>
 
+// Settings for a run of the verification table.
+struct verification_options
+{
+	// Only run tests whose name contains this string.
+	std::string filter;
+
+	// Number of tests to run at once. 1 runs them in order on the calling thread.
+	// Parallel tests share the thread pool with days' own parallel work, so asking for more
+	// jobs than utils::get_thread_count() only queues them.
+	int num_jobs = 1;
+
+	// Timings from previous runs are read from (and written back to) this file.
+	// They are used to start the slowest tests first when running in parallel.
+	// Leave blank to neither read nor write timings.
+	std::string timings_file;
+
+	// Benchmark mode. Each test is run warmup_iterations times untimed, then timed until it has
+	// run at least benchmark_iterations times and for at least benchmark_min_time. The reported
+	// time is then the median, with the spread of timings reported alongside it.
+	// Leave these alone to time a single run of each test.
+	int warmup_iterations = 0;
+	int benchmark_iterations = 1;
+	std::chrono::milliseconds benchmark_min_time{ 0 };
+
+	// Machine-readable copies of the results, one record per test run. Leave blank to skip.
+	std::string json_output_file;
+	std::string csv_output_file;
+
+	// Compare median timings against a baseline from a previous run. Any test that slowed down
+	// by more than regression_threshold standard errors, and by at least regression_min_slowdown
+	// of its baseline median, counts as a regression and fails the run. So does a baseline file
+	// that can't be read. This needs repeated runs (see benchmark mode) on both sides to measure
+	// the noise; tests without them are reported as unchecked.
+	std::string baseline_file;
+	double regression_threshold = 3.0;
+	double regression_min_slowdown = 0.05;
+
+	// Record this run's timings as a baseline for later runs.
+	std::string save_baseline_file;
+
+	// Count CPU events (cycles, instructions, cache and branch misses) while each test runs.
+	// Only Linux supports this; elsewhere the counts are left out.
+	bool collect_counters = false;
+
+	// Write a Chrome trace-event timeline of the run here, for chrome://tracing or Perfetto.
+	// Each test gets a span, as do its phases and anything the day marks with ADVENT_TRACE_SCOPE.
+	// Release builds leave tracing out, so this only works in debug or AOC_TRACE builds.
+	std::string trace_file;
+
+	// Keep the thread running the tests on this logical core, so the scheduler can't move it
+	// between cores (and their caches and clock speeds) mid-measurement. -1 leaves it free.
+	// Only applies when tests run one at a time. Days' own parallel work still runs on the
+	// thread pool, so use one thread (utils::set_thread_count) to keep everything on the core.
+	int pin_to_core = -1;
+
+	// Run the tests at a raised scheduling priority, so other work is less likely to interrupt them.
+	// This usually needs administrator or root rights; the run carries on without it if not.
+	bool raise_priority = false;
+
+	// Stop any test that takes longer than this, counting warmups and repeats, and report it
+	// as timed out. Days check for this at the heads of their long loops. Zero means no limit.
+	std::chrono::milliseconds test_timeout{ 0 };
+};
+
+// Returns false if any test failed or regressed against the baseline.
+bool verify_all(const verification_options& options);
 bool verify_all(const std::string& filter);
 bool verify_all();
\ No newline at end of file
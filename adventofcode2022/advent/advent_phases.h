@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <string_view>
+#include <vector>
+
+namespace advent
+{
+	// Time spent in a named phase of a test.
+	struct phase_timing
+	{
+		std::string_view name;
+		std::chrono::nanoseconds time{ 0 };
+	};
+
+	// Marks code as belonging to a named phase of the running test, from construction until
+	// destruction or the next call to next():
+	//
+	//     advent::phase_timer phase{ "parse" };
+	//     const Grid grid = get_grid(input);
+	//     phase.next("solve");
+	//
+	// Phases nest, and time spent in an inner phase is not counted towards the outer one.
+	// Names are not copied, so use string literals.
+	class phase_timer
+	{
+		using clock = std::chrono::high_resolution_clock;
+		std::string_view m_name;
+		clock::time_point m_start;
+		phase_timer* m_parent;
+		void record(clock::time_point now);
+	public:
+		explicit phase_timer(std::string_view name);
+		phase_timer(const phase_timer&) = delete;
+		phase_timer& operator=(const phase_timer&) = delete;
+		~phase_timer();
+		void next(std::string_view name);
+	};
+
+	// Used by the test harness. Phase timings on this thread are only kept between these calls.
+	void start_phase_collection();
+	std::vector<phase_timing> stop_phase_collection();
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <vector>
+
+#include "advent_types.h"
+#include "advent_phases.h"
+#include "advent_allocations.h"
+#include "advent_counters.h"
+#include "advent_host.h"
+
+// Result a test can give.
+enum class test_status : char
+{
+	pass,
+	fail,
+	unknown,
+	filtered,
+	timeout
+};
+
+// Spread of timings over repeated runs of a test.
+struct timing_statistics
+{
+	std::size_t num_samples = 0;
+	std::chrono::nanoseconds min{ 0 };
+	std::chrono::nanoseconds median{ 0 };
+	std::chrono::nanoseconds mean{ 0 };
+	std::chrono::nanoseconds p90{ 0 };
+	std::chrono::nanoseconds p99{ 0 };
+	std::chrono::nanoseconds std_dev{ 0 };
+	double coefficient_of_variation = 0.0;
+};
+
+// Full results of a test.
+struct test_result
+{
+	std::string name;
+	std::string result;
+	std::string expected;
+	test_status status = test_status::unknown;
+	std::chrono::nanoseconds time_taken;
+	timing_statistics timings;
+
+	// Mean time per run spent in each phase the test marked with advent::phase_timer.
+	std::vector<advent::phase_timing> phases;
+
+	// Heap use per run. Only filled in when built with AOC_TRACK_ALLOCATIONS.
+	advent::allocation_stats allocations;
+
+	// Mean CPU events per run on the thread running the test, if they were asked for and could be counted.
+	advent::hardware_counters counters;
+};
+
+std::string_view to_string(test_status status);
+
+// A solver's answer as it is printed and compared.
+std::string to_string(const ResultType& rt);
+
+// Sorts the samples to find their median and percentiles. There must be at least one.
+timing_statistics get_timing_statistics(std::vector<std::chrono::nanoseconds> samples);
+
+// A time in the largest unit that keeps it readable, e.g. "12.3ms".
+std::string to_human_readable(std::chrono::nanoseconds time);
+
+// Quotes str and escapes it for use as a JSON string.
+std::string json_escape(std::string_view str);
+
+// Write one record per test that was run (filtered tests are skipped), each including the
+// host the run was on so results from different machines can be pooled.
+// Returns false if the file could not be opened.
+bool write_results_json_lines(const std::string& filename, const test_result* first, const test_result* last, const advent::host_info& host);
+bool write_results_csv(const std::string& filename, const test_result* first, const test_result* last, const advent::host_info& host);
+
+// Timings from a previous run to compare against.
+struct baseline_entry
+{
+	std::chrono::nanoseconds median{ 0 };
+	std::chrono::nanoseconds std_dev{ 0 };
+	std::size_t num_samples = 0;
+};
+
+using timing_baseline = std::map<std::string, baseline_entry, std::less<>>;
+
+// A test whose median got slower than the noise in the two runs can explain.
+struct timing_regression
+{
+	std::string name;
+	baseline_entry before;
+	timing_statistics after;
+	double z_score = 0.0;
+};
+
+// Each line of a baseline file is "<median ns> <std dev ns> <samples> <test name>".
+// Returns nothing if the file can't be opened.
+std::optional<timing_baseline> read_baseline(const std::string& filename);
+
+// Adds the tests that ran to the baseline in filename, keeping entries for any that didn't.
+bool write_baseline(const std::string& filename, const test_result* first, const test_result* last);
+
+struct regression_check
+{
+	std::vector<timing_regression> regressions;
+
+	// Tests that ran and were compared against the baseline.
+	std::size_t num_compared = 0;
+
+	// Tests that ran but couldn't be compared: they had fewer than two timed runs on either side,
+	// so their noise can't be measured, or the baseline has no entry for them.
+	std::size_t num_too_few_samples = 0;
+	std::size_t num_not_in_baseline = 0;
+};
+
+// A test regresses if the change in its median is more than z_threshold standard errors and
+// at least min_relative_slowdown of the baseline median. The second rule stops tests repeated
+// thousands of times, whose standard error is tiny, failing on drift between runs.
+regression_check find_regressions(const timing_baseline& baseline, const test_result* first, const test_result* last,
+	double z_threshold, double min_relative_slowdown);
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Settings for a run of the complexity-scaling suite, which times each day's solvers on generated
+// inputs of doubling size to find out how their running time grows.
+struct scaling_options
+{
+	// Only run solvers whose names (e.g. advent_twenty_p1) contain this string.
+	std::string filter;
+
+	// Each solver starts at its day's base size and doubles num_sizes - 1 times, stopping early
+	// once a size takes longer than max_time_per_size.
+	int num_sizes = 6;
+	std::chrono::milliseconds max_time_per_size{ 2000 };
+
+	// Each size is timed at least repetitions times and for at least min_time, and the median is kept.
+	int repetitions = 3;
+	std::chrono::milliseconds min_time{ 20 };
+
+	// Seed for the generated inputs.
+	std::uint64_t seed = 0;
+};
+
+// How well timings match a growth rate such as O(n log n).
+struct complexity_fit
+{
+	std::string_view name;
+
+	// Spread of the timings around the best multiple of the growth rate, in log space.
+	// Lower is better; 0 is a perfect fit.
+	double residual = 0.0;
+};
+
+// A solver's timings on growing inputs, and what they fit.
+struct scaling_result
+{
+	std::string name;
+	std::string_view scale_description;
+	std::vector<std::size_t> sizes;
+	std::vector<std::chrono::nanoseconds> times;
+
+	// Slope of log(time) against log(size), so 1 means linear and 2 quadratic.
+	double exponent = 0.0;
+
+	// Every growth rate tried, best first.
+	std::vector<complexity_fit> fits;
+
+	// Set if the solver threw or ran out of time before the sizes could be finished.
+	std::string error;
+};
+
+// Fits timings to O(log n), O(n), O(n log n), O(n^2) and so on.
+// Needs at least two sizes to measure a slope.
+void fit_complexity(scaling_result& result);
+
+// Runs the suite, printing a table per solver and a summary of empirical exponents.
+// Returns false if any solver failed on a generated input.
+bool run_scaling_suite(const scaling_options& options);
\ No newline at end of file
@@ -26,6 +26,10 @@ static const verification_test tests[] =
 {
 	TESTCASE(day_one_p1_a,24000),
 	TESTCASE(day_one_p2_a,45000),
+	TESTCASE(day_one_p1_crlf,24000),
+	TESTCASE(day_one_p2_crlf,45000),
+	TESTCASE(day_one_p1_crlf_streamed,24000),
+	TESTCASE(day_one_p2_crlf_streamed,45000),
 	DAY(one,70698,206643),
 	TESTCASE(day_two_p1_a,15),
 	TESTCASE(day_two_p2_a,12),
@@ -92,7 +96,9 @@ static const verification_test tests[] =
 	DAY(fifteen,4725496,12051287042458),
 	TESTCASE(day_sixteen_p1_a,1651),
 	TESTCASE(day_sixteen_p2_a,1707),
+	BOTH_TESTCASE(day_sixteen_both_a,1651,1707),
 	DAY(sixteen,1871,2416),
+	BOTH_DAY(sixteen,1871,2416),
 	TESTCASE(day_seventeen_p1_a,3068),
 	TESTCASE(day_seventeen_p2_a,1514285714288),
 	DAY(seventeen,3100,1540634005751),
@@ -112,17 +118,23 @@ static const verification_test tests[] =
 	DAY(twentyone,85616733059734,3560324848168),
 	TESTCASE(day_twentytwo_p1_a,6032),
 	TESTCASE(day_twentytwo_p2_a,5031),
+	BOTH_TESTCASE(day_twentytwo_both_a,6032,5031),
 	DAY(twentytwo,76332,Dummy{}),
+	BOTH_DAY(twentytwo,76332,Dummy{}),
 	TESTCASE(day_twentythree_p1_a, 25),
 	TESTCASE(day_twentythree_p1_b, 110),
 	TESTCASE(day_twentythree_p2_a, 4),
 	TESTCASE(day_twentythree_p2_b, 20),
+	TESTCASE(day_twentythree_conway_glider, 5),
 	DAY(twentythree,4208,1016),
 	TESTCASE(day_twentyfour_p1_a, 10),
 	TESTCASE(day_twentyfour_p1_b, 18),
 	TESTCASE(day_twentyfour_p2_a, 30),
 	TESTCASE(day_twentyfour_p2_b, 54),
+	BOTH_TESTCASE(day_twentyfour_both_a,10,30),
+	BOTH_TESTCASE(day_twentyfour_both_b,18,54),
 	DAY(twentyfour,249,735),
+	BOTH_DAY(twentyfour,249,735),
 	TESTCASE(day_twentyfive_p1_std<28901>,976),
 	TESTCASE(day_twentyfive_p1_std<1>,1),
 	TESTCASE(day_twentyfive_p1_std<2>,2),
@@ -163,5 +175,7 @@ static const verification_test tests[] =
 #undef FUNC_NAME
 #undef TEST_DECL
 #undef DAY
+#undef BOTH_TESTCASE
+#undef BOTH_DAY
 #undef DUMMY
 #undef DUMMY_DAY
\ No newline at end of file
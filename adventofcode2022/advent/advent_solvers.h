@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <array>
+#include <string_view>
+#include <chrono>
+#include <istream>
+
+#include "advent_types.h"
+
+namespace advent
+{
+	constexpr int first_solved_day = 1;
+	constexpr int last_solved_day = 25;
+
+	using solver_func = ResultType(*)();
+
+	// The function that solves a part (1 or 2) of a day's puzzle input, e.g. advent_twenty_p1,
+	// or nullptr if there is no such day or part.
+	solver_func get_solver(int day, int part);
+
+	// Its name as it appears in the test table, e.g. "advent_twenty_p1".
+	std::string_view get_solver_name(int day, int part);
+
+	using both_solver_func = BothPartsResult(*)();
+
+	// The function that solves both parts of a day's puzzle input from one parse, e.g. advent_sixteen_both,
+	// or nullptr if there is no such day. Days that don't have one get a function that calls each part in turn.
+	both_solver_func get_both_solver(int day);
+
+	enum class solve_status : char
+	{
+		ok,
+		error,
+		timeout
+	};
+
+	std::string_view to_string(solve_status status);
+
+	struct solve_outcome
+	{
+		solve_status status = solve_status::error;
+		std::string result;
+
+		// Why it failed, if it did.
+		std::string error;
+		std::chrono::nanoseconds time{ 0 };
+	};
+
+	// Runs a day's solver on input in place of its puzzle file, on the calling thread, stopping it
+	// after timeout if that is nonzero. Trailing newlines are dropped from input first, as the
+	// solvers expect inputs without one. Failures are reported in the outcome rather than thrown.
+	solve_outcome solve_input(int day, int part, std::string_view input, std::chrono::milliseconds timeout);
+
+	// As solve_input, but reads the input from a stream such as stdin. Days that read their input
+	// a line at a time work on it as it arrives; the rest read it all in first.
+	solve_outcome solve_stream(int day, int part, std::istream& input, std::chrono::milliseconds timeout);
+
+	// As solve_input, but solves both parts with get_both_solver. The parts share a status and
+	// time, which is the time to solve both.
+	std::array<solve_outcome, 2> solve_both_input(int day, std::string_view input, std::chrono::milliseconds timeout);
+}
\ No newline at end of file
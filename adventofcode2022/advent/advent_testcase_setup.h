@@ -4,6 +4,7 @@
 #include <string>
 
 using TestFunc = std::function<ResultType()>;
+using BothTestFunc = std::function<BothPartsResult()>;
 
 // This describes a test to run.
 struct verification_test
@@ -23,10 +24,16 @@ verification_test make_test(std::string name, TestFunc func, std::string result)
 verification_test make_test(std::string name, TestFunc func, Dummy);
 verification_test make_test(std::string name, Dummy, Dummy);
 
+// A test of a function that solves both parts at once. It passes if both answers match.
+verification_test make_both_test(std::string name, BothTestFunc func, ResultType part_one_result, ResultType part_two_result);
+verification_test make_both_test(std::string name, BothTestFunc func, ResultType part_one_result, Dummy);
+
 #define ARG(func_name) std::string{ #func_name },func_name
 #define TESTCASE(func_name,expected_result) make_test(ARG(func_name),expected_result)
 #define FUNC_NAME(day_num,part_num) advent_ ## day_num ## _p ## part_num
 #define TEST_DECL(day_num,part_num,expected_result) TESTCASE(FUNC_NAME(day_num,part_num),expected_result)
+#define BOTH_TESTCASE(func_name,part1_result,part2_result) make_both_test(ARG(func_name),part1_result,part2_result)
+#define BOTH_DAY(day_num,part1_result,part2_result) BOTH_TESTCASE(advent_ ## day_num ## _both,part1_result,part2_result)
 #define DAY(day_num,part1_result,part2_result) \
 	TEST_DECL(day_num,1,part1_result), \
 	TEST_DECL(day_num,2,part2_result)
\ No newline at end of file
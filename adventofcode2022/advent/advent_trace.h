@@ -0,0 +1,80 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// Tracing is compiled into debug builds and left out of release builds entirely.
+// Define AOC_TRACE to 0 or 1 in the project settings to override that.
+#ifndef AOC_TRACE
+#ifdef NDEBUG
+#define AOC_TRACE 0
+#else
+#define AOC_TRACE 1
+#endif
+#endif
+
+namespace advent
+{
+	constexpr bool tracing_compiled_in = AOC_TRACE != 0;
+
+	// Used by the test harness. Events are only recorded between these calls, and are written
+	// as Chrome trace-event JSON, which chrome://tracing and Perfetto can both open.
+	// write_trace returns false if the file couldn't be written or tracing isn't compiled in.
+	void start_tracing();
+	bool write_trace(const std::string& filename);
+
+#if AOC_TRACE
+	bool is_tracing();
+
+	// Records a span from construction to destruction on the calling thread.
+	// Names are not copied, so use string literals or strings that live until the trace is written.
+	class trace_span
+	{
+		std::string_view m_name;
+		long long m_start_ns;
+	public:
+		explicit trace_span(std::string_view name);
+		trace_span(const trace_span&) = delete;
+		trace_span& operator=(const trace_span&) = delete;
+		~trace_span();
+	};
+
+	// Records a completed span directly, for code that already has its own timestamps.
+	void trace_complete(std::string_view name, long long start_ns, long long end_ns);
+	long long trace_now_ns();
+
+	// A value plotted over time, such as the size of a search frontier.
+	void trace_counter(std::string_view name, double value);
+
+	// A single point in time.
+	void trace_instant(std::string_view name);
+
+	// A single point in time, labelled with text that is copied, so it needn't outlive the call.
+	void trace_message(std::string_view text);
+#endif
+
+	// Where days write their debug output. It goes to stdout, and while a trace is running each
+	// line also appears in it as an instant on the writing thread, next to the spans around it.
+	std::ostream& debug_log();
+
+	// Swallows debug output, for days that have it turned off.
+	struct null_log
+	{
+		template <typename T>
+		const null_log& operator<<(const T&) const noexcept { return *this; }
+	};
+}
+
+// Use these rather than the functions above so release builds pay nothing at all.
+#if AOC_TRACE
+#define ADVENT_TRACE_CONCAT_INNER(a, b) a##b
+#define ADVENT_TRACE_CONCAT(a, b) ADVENT_TRACE_CONCAT_INNER(a, b)
+#define ADVENT_TRACE_SCOPE(name) const advent::trace_span ADVENT_TRACE_CONCAT(advent_trace_span_, __LINE__){ name }
+#define ADVENT_TRACE_COUNTER(name, value) advent::trace_counter(name, static_cast<double>(value))
+#define ADVENT_TRACE_INSTANT(name) advent::trace_instant(name)
+#else
+#define ADVENT_TRACE_SCOPE(name) static_cast<void>(0)
+#define ADVENT_TRACE_COUNTER(name, value) static_cast<void>(0)
+#define ADVENT_TRACE_INSTANT(name) static_cast<void>(0)
+#endif
\ No newline at end of file
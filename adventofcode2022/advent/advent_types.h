@@ -5,6 +5,14 @@
 #include <cstdint>
 
 using ResultType = std::variant<std::string, int64_t>;
+
+// Both answers from a day that parses its input once for both parts.
+struct BothPartsResult
+{
+	ResultType part_one;
+	ResultType part_two;
+};
+
 enum class AdventDay
 {
 	One,
@@ -11,25 +11,26 @@
 #include <string_view>
 
 #include "advent_assert.h"
+#include "advent_phases.h"
+#include "advent_trace.h"
+#include "advent_cancellation.h"
+#include "advent_input.h"
 
 namespace advent
 {
-
-	inline std::ifstream open_puzzle_input(int day)
+	// Both of these read from the input cache, so only the first call for each file touches the disk.
+	// An input that is being streamed in (see puzzle_input_override) is read straight from the stream.
+	inline input_stream open_puzzle_input(int day)
 	{
-		std::ostringstream name;
-		name << "advent" << day << "/advent" << day << ".txt";
-		auto result = std::ifstream{ name.str() };
-		AdventCheck(result.is_open());
-		return result;
+		if (std::streambuf* source = get_puzzle_stream(day))
+		{
+			return input_stream{ *source };
+		}
+		return input_stream{ get_puzzle_input(day) };
 	}
 
-	inline std::ifstream open_testcase_input(int day, char id)
+	inline input_stream open_testcase_input(int day, char id)
 	{
-		std::ostringstream name;
-		name << "advent" << day << "/testcase_" << id << ".txt";
-		auto result = std::ifstream{ name.str() };
-		AdventCheck(result.is_open());
-		return result;
+		return input_stream{ get_testcase_input(day, id) };
 	}
 }
\ No newline at end of file
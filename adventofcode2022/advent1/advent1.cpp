@@ -26,9 +26,9 @@
 namespace
 {
 #if DAY1DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
@@ -54,6 +54,27 @@ namespace
 		};
 	}
 	
+	// Testcase a as it reads from a checkout with Windows line endings.
+	std::string testcase_crlf()
+	{
+		std::string result = testcase_a().str();
+		for (std::size_t pos = result.find('\n'); pos != std::string::npos; pos = result.find('\n', pos + 2))
+		{
+			result.insert(pos, 1, '\r');
+		}
+		return result;
+	}
+
+	// The same, with the first line padded with leading zeros so its carriage return is the last
+	// character of the first chunk a stream reads, and its newline the first of the next.
+	std::string testcase_crlf_split()
+	{
+		constexpr std::size_t chunk_size = 4096;
+		std::string result = testcase_crlf();
+		result.insert(0, chunk_size - 1 - result.find('\r'), '0');
+		return result;
+	}
+
 	using PayloadType = int;
 	using ElfPayload = std::string_view;
 	namespace stdr = std::ranges;
@@ -65,16 +86,27 @@ namespace
 		return result;
 	}
 
-	PayloadType get_biggest_payload(std::istream& input)
+	// Elves are separated by blank lines.
+	constexpr const char* elf_separator = "\n\n";
+
+	template <typename ElfIt>
+	PayloadType get_biggest_payload(ElfIt first, ElfIt last)
 	{
-		using IBI = utils::istream_block_iterator;
-		const PayloadType result = std::transform_reduce(IBI{input},IBI{},std::numeric_limits<PayloadType>::min(),utils::Larger<PayloadType>{},get_elf_payload);
+		const PayloadType result = std::transform_reduce(first,last,std::numeric_limits<PayloadType>::min(),utils::Larger<PayloadType>{},get_elf_payload);
 		return result;
 	}
 
 	PayloadType solve_p1(std::istream& input)
 	{
-		return get_biggest_payload(input);
+		using IBI = utils::istream_block_iterator;
+		return get_biggest_payload(IBI{input},IBI{});
+	}
+
+	// Works directly on the mapped input, so no elf is ever copied.
+	PayloadType solve_p1(std::string_view input)
+	{
+		using SLI = utils::string_line_iterator;
+		return get_biggest_payload(SLI{input,elf_separator},SLI{});
 	}
 }
 
@@ -109,10 +141,10 @@ namespace
 		return result;
 	}
 
-	PayloadType solve_p2(std::istream& input)
+	template <typename ElfIt>
+	PayloadType get_top_payloads(ElfIt first, ElfIt last)
 	{
-		using IBI = utils::istream_block_iterator;
-		const TopPayloads top_payloads = std::transform_reduce(IBI{input},IBI{},
+		const TopPayloads top_payloads = std::transform_reduce(first,last,
 			TopPayloads{},
 			merge_top_payloads,
 			[](const ElfPayload& elf_payload)
@@ -125,6 +157,18 @@ namespace
 		const PayloadType result = std::accumulate(begin(top_payloads.data),end(top_payloads.data),PayloadType{0});
 		return result;
 	}
+
+	PayloadType solve_p2(std::istream& input)
+	{
+		using IBI = utils::istream_block_iterator;
+		return get_top_payloads(IBI{input},IBI{});
+	}
+
+	PayloadType solve_p2(std::string_view input)
+	{
+		using SLI = utils::string_line_iterator;
+		return get_top_payloads(SLI{input,elf_separator},SLI{});
+	}
 }
 
 ResultType day_one_p1_a()
@@ -139,16 +183,46 @@ ResultType day_one_p2_a()
 	return solve_p2(input);
 }
 
+// These go through the puzzle input, so they see the same line ending handling as the input files.
+ResultType day_one_p1_crlf()
+{
+	const std::string text = testcase_crlf();
+	const advent::puzzle_input_override input{ 1, text };
+	return advent_one_p1();
+}
+
+ResultType day_one_p2_crlf()
+{
+	const std::string text = testcase_crlf();
+	const advent::puzzle_input_override input{ 1, text };
+	return advent_one_p2();
+}
+
+ResultType day_one_p1_crlf_streamed()
+{
+	std::istringstream stream{ testcase_crlf_split() };
+	const advent::puzzle_input_override input{ 1, stream };
+	return advent_one_p1();
+}
+
+ResultType day_one_p2_crlf_streamed()
+{
+	std::istringstream stream{ testcase_crlf_split() };
+	const advent::puzzle_input_override input{ 1, stream };
+	return advent_one_p2();
+}
+
+// Streamed inputs are taken an elf at a time as they arrive, rather than read in whole first.
 ResultType advent_one_p1()
 {
 	auto input = advent::open_puzzle_input(1);
-	return solve_p1(input);
+	return input.is_streaming() ? solve_p1(input) : solve_p1(input.view());
 }
 
 ResultType advent_one_p2()
 {
 	auto input = advent::open_puzzle_input(1);
-	return solve_p2(input);
+	return input.is_streaming() ? solve_p2(input) : solve_p2(input.view());
 }
 
 #undef DAY1DBG
@@ -4,6 +4,10 @@
 
 ResultType day_one_p1_a();
 ResultType day_one_p2_a();
+ResultType day_one_p1_crlf();
+ResultType day_one_p2_crlf();
+ResultType day_one_p1_crlf_streamed();
+ResultType day_one_p2_crlf_streamed();
 
 ResultType advent_one_p1();
 ResultType advent_one_p2();
\ No newline at end of file
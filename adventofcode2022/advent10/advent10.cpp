@@ -15,9 +15,9 @@
 namespace
 {
 #if DAY10DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
@@ -209,7 +209,7 @@ namespace
 		};
 	}
 
-	std::ifstream testcase_b()
+	advent::input_stream testcase_b()
 	{
 		return advent::open_testcase_input(10, 'b');
 	}
@@ -15,9 +15,9 @@
 namespace
 {
 #if DAY11DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
@@ -336,7 +336,9 @@ namespace
 	template <Item WorryDivisor>
 	int64_t solve_generic(std::istream& input, int num_rounds)
 	{
+		advent::phase_timer phase{ "parse" };
 		auto monkeys = parse_monkeys<WorryDivisor>(input);
+		phase.next("solve");
 		simlulate_n_rounds(monkeys, num_rounds);
 		const int64_t result = calculate_monkey_business(monkeys, 2);
 		return result;
@@ -15,9 +15,9 @@
 namespace
 {
 #if DAY12DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
@@ -94,9 +94,12 @@ namespace
 
 	int solve_p1(std::istream& input)
 	{
+		advent::phase_timer phase{ "parse" };
 		const Grid grid = get_grid(input);
+		phase.next("preprocess");
 		const coords start_point = get_point(grid, START_POINT);
 		const coords ending_point = get_point(grid, END_POINT);
+		phase.next("solve");
 
 		auto heuristic_fn = [ending_point](coords location, char node)
 		{
@@ -111,35 +114,25 @@ namespace
 
 namespace
 {
-	// Search backwards from E until we find an 'a'
+	// The distance to E from every 'a', found in one search outwards from all of them at once.
 
-	bool is_at_end(coords location, char node)
+	bool can_step(coords from_pos, char from_node, coords to_pos, char to_node)
 	{
-		const int height = get_height(node);
-		return height == 'a';
+		return search_cost<AdventDay::One>(from_pos, from_node, to_pos, to_node).has_value();
 	}
 
 	int solve_p2(std::istream& input)
 	{
+		advent::phase_timer phase{ "parse" };
 		const Grid grid = get_grid(input);
 
-		const coords start_point = get_point(grid, END_POINT);
+		phase.next("preprocess");
+		const coords end_point = get_point(grid, END_POINT);
+		const auto start_points = grid.get_all_coordinates_by_predicate([](char node) {return get_height(node) == 'a'; });
 
-		auto all_end_points = grid.get_all_coordinates_by_predicate([](char node) {return get_height(node) == 'a'; });
-		auto heuristic_fn = [](coords location, char node) {return 0.0f; };
-		// This heuristic is signicantly slower than using no heuristic. LOL.
-		/*auto heuristic_fn = [&all_end_points](coords location, char node)
-		{
-			auto partial_heuristic = [location, node](coords end_point)
-			{
-				return get_heuristic(location, node, end_point, 'a');
-			};
-			const coords target = utils::min_transform(begin(all_end_points), end(all_end_points), partial_heuristic);
-			return partial_heuristic(target);
-		};*/
-
-		const auto path = grid.get_path(start_point, is_at_end, search_cost<AdventDay::Two>,heuristic_fn);
-		return static_cast<int>(path.size()) - 1;
+		phase.next("solve");
+		const utils::grid<int> distances = grid.distance_field(start_points, can_step);
+		return distances.at(end_point);
 	}
 }
 
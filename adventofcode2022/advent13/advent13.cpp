@@ -15,9 +15,9 @@
 namespace
 {
 #if DAY13DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
@@ -349,6 +349,7 @@ namespace
 	int solve_p2(std::istream& input)
 	{
 		using ILI = utils::istream_line_iterator;
+		advent::phase_timer phase{ "parse" };
 		const std::array<std::string, 2> dividers{ "[[2]]" , "[[6]]" };
 		utils::small_vector<std::string, 1> all_packets(begin(dividers),end(dividers));
 		utils::transform_if_pre(ILI{ input }, ILI{}, std::back_inserter(all_packets),
@@ -361,6 +362,7 @@ namespace
 				return !line.empty(); 
 			});
 
+		phase.next("solve");
 		std::ranges::sort(all_packets, [](std::string_view left, std::string_view right)
 			{
 				return are_packets_in_order(left, right);
@@ -15,9 +15,9 @@
 namespace
 {
 #if DAY14DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
@@ -212,7 +212,9 @@ namespace
 
 	int solve_generic(std::istream& input, Block floor_type)
 	{
+		advent::phase_timer phase{ "parse" };
 		Cave caves = parse_caves(input, floor_type);
+		phase.next("solve");
 		const int result = fill_with_sand(std::move(caves));
 		return result;
 	}
@@ -15,9 +15,9 @@
 namespace
 {
 #if DAY15DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
@@ -207,7 +207,9 @@ namespace
 
 	int solve_p1_generic(std::istream& input, int y_slice)
 	{
+		advent::phase_timer phase{ "parse" };
 		const std::vector<Sensor> sensors = parse_all_sensors(input);
+		phase.next("solve");
 		utils::sorted_vector<int> beacon_x_coords;
 		utils::ranges::transform_if_pre(sensors, std::back_inserter(beacon_x_coords),
 			[](const Sensor& s)
@@ -244,7 +246,9 @@ namespace
 
 	int64_t solve_p2_generic(std::istream& input, int max_size)
 	{
+		advent::phase_timer phase{ "parse" };
 		const std::vector<Sensor> sensors = parse_all_sensors(input, 0, max_size + 1);
+		phase.next("solve");
 		std::vector<AxisRange> covered_areas;
 		for (int y : utils::int_range{ max_size + 1 })
 		{
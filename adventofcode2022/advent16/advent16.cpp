@@ -15,9 +15,9 @@
 namespace
 {
 #if DAY16DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
@@ -29,6 +29,8 @@ namespace
 #include "swap_remove.h"
 #include "transform_if.h"
 #include "int_range.h"
+#include "thread_pool.h"
+#include "arena_resource.h"
 
 #include <format>
 
@@ -308,7 +310,7 @@ namespace
 		best_possible_flow = calculate_best_possible_flow(valves, *this);
 	}
 
-	void append_next_steps(std::vector<SearchNode>& out_nodes, const ValveMap& valves, SearchNode base_node)
+	void append_next_steps(std::pmr::vector<SearchNode>& out_nodes, const ValveMap& valves, SearchNode base_node)
 	{
 		const int original_time = base_node.time_remaining;
 		const ValveId original_location_id = base_node.current_location;
@@ -341,10 +343,14 @@ namespace
 		}
 	}
 
-	FlowTotal get_best_possible_flow(const ValveMap& valves, ValveId starting_location,utils::sorted_vector<ValveId> valves_to_open, int starting_time, FlowTotal flow_cut_off)
+	// Searches that run in parallel with others should turn log_progress off, as their progress lines would garble each other.
+	FlowTotal get_best_possible_flow(const ValveMap& valves, ValveId starting_location,utils::sorted_vector<ValveId> valves_to_open, int starting_time, FlowTotal flow_cut_off, bool log_progress = true)
 	{
-		std::vector<SearchNode> nodes_to_search;
-		std::vector<SearchNode> searched_nodes;
+		ADVENT_TRACE_SCOPE("get_best_possible_flow");
+		// Both lists only live for this search, which can run many times for part two.
+		const utils::scratch_scope scratch;
+		std::pmr::vector<SearchNode> nodes_to_search{ scratch.resource() };
+		std::pmr::vector<SearchNode> searched_nodes{ scratch.resource() };
 		FlowTotal best_result_so_far = -1;
 		{
 			SearchNode initial_node;
@@ -374,17 +380,24 @@ namespace
 		Stat stat_dominated;
 		Stat stat_end_points_found;
 
-		log << '\n';
+		if (log_progress)
+		{
+			log << '\n';
+		}
 
 		while (!nodes_to_search.empty())
 		{
-			log << std::format("\rBest: {} Searched: {} Unsearched: {} EPs: {} Dom: {} BCTL: {}",
-				best_result_so_far,
-				searched_nodes.size(),
-				nodes_to_search.size(),
-				stat_end_points_found(),
-				stat_dominated(),
-				stat_best_case_too_low());
+			advent::check_cancellation();
+			if (log_progress)
+			{
+				log << std::format("\rBest: {} Searched: {} Unsearched: {} EPs: {} Dom: {} BCTL: {}",
+					best_result_so_far,
+					searched_nodes.size(),
+					nodes_to_search.size(),
+					stat_end_points_found(),
+					stat_dominated(),
+					stat_best_case_too_low());
+			}
 			const auto best_match = std::max_element(begin(nodes_to_search), end(nodes_to_search),
 				[](const SearchNode& left, const SearchNode& right)
 				{
@@ -402,7 +415,12 @@ namespace
 			const SearchNode current_node = *best_match;
 			utils::swap_remove(nodes_to_search, best_match);
 
-			best_result_so_far = std::max(best_result_so_far, current_node.current_flow);
+			if (current_node.current_flow > best_result_so_far)
+			{
+				best_result_so_far = current_node.current_flow;
+				ADVENT_TRACE_COUNTER("day16 best flow", best_result_so_far);
+				ADVENT_TRACE_COUNTER("day16 nodes to search", nodes_to_search.size());
+			}
 
 			if (current_node.is_end_point())
 			{
@@ -449,7 +467,10 @@ namespace
 
 			searched_nodes.push_back(current_node);
 		}
-		log << '\n';
+		if (log_progress)
+		{
+			log << '\n';
+		}
 		return best_result_so_far;
 	}
 
@@ -465,19 +486,24 @@ namespace
 
 	}
 
-	template <AdventDay day>
-	FlowTotal solve_generic(std::istream& input, std::string_view starting_location_str, int time)
+	// The valve map with the valves that can't be opened taken out, which both parts search.
+	struct ValveNetwork
 	{
-		const ValveId starting_location{ starting_location_str };
-		const ValveMap valves = [&input, starting_location]()
-		{
-			ValveMap all_valves = parse_all_locations(input);
-			const ValveMap result = simplify_valve_map(std::move(all_valves), starting_location);
-			return result;
-		}();
-
+		ValveMap valves;
+		ValveId starting_location;
 		utils::sorted_vector<ValveId> valves_to_open;
-		utils::transform_if_pre(begin(valves), end(valves), std::back_inserter(valves_to_open),
+	};
+
+	ValveNetwork prepare_network(std::istream& input, std::string_view starting_location_str)
+	{
+		ValveNetwork result;
+		result.starting_location = ValveId{ starting_location_str };
+		advent::phase_timer phase{ "parse" };
+		ValveMap all_valves = parse_all_locations(input);
+		phase.next("preprocess");
+		result.valves = simplify_valve_map(std::move(all_valves), result.starting_location);
+
+		utils::transform_if_pre(begin(result.valves), end(result.valves), std::back_inserter(result.valves_to_open),
 			[](const Location& loc)
 			{
 				return loc.valve.id;
@@ -486,7 +512,17 @@ namespace
 			{
 				return loc.valve.can_open();
 			});
+		return result;
+	}
 
+	template <AdventDay day>
+	FlowTotal solve_generic(const ValveNetwork& network, int time)
+	{
+		const ValveMap& valves = network.valves;
+		const ValveId& starting_location = network.starting_location;
+		const utils::sorted_vector<ValveId>& valves_to_open = network.valves_to_open;
+
+		advent::phase_timer phase{ "solve" };
 		if constexpr (day == AdventDay::One)
 		{
 			const FlowTotal result = get_best_possible_flow(valves, starting_location, valves_to_open, time, 0);
@@ -498,44 +534,73 @@ namespace
 			using MaskType = uint64_t;
 			AdventCheck(valves_to_open.size() >= 1u);
 			AdventCheck(valves_to_open.size() <= (sizeof(MaskType) * CHAR_BIT));
-			FlowTotal best_result = 0;
 			const MaskType split_mask_max = MaskType{ 1 } << (valves_to_open.size() - 1);
-			utils::sorted_vector<ValveId> low_valves, high_valves;
-			for (MaskType mask : utils::int_range{ split_mask_max })
-			{
-				low_valves.clear();
-				high_valves.clear();
-				for (auto idx : utils::int_range{ valves_to_open.size() })
+
+			// Splits are searched in parallel. Any split's total is a lower bound on the answer, so
+			// every split can use the best found so far to cut its short search off, whichever thread found it.
+			std::atomic<FlowTotal> best_result{ 0 };
+			const advent::cancellation_token token = advent::get_cancellation_token();
+			utils::parallel_for_ranges(MaskType{ 0 }, split_mask_max, [&](MaskType first_mask, MaskType last_mask)
 				{
-					const MaskType bit = MaskType{ 1u } << idx;
-					const MaskType mask_bit = mask & bit;
-					const bool is_high = mask_bit != 0;
-					utils::sorted_vector<ValveId>& valves_to_add_to = (is_high ? high_valves : low_valves);
-					valves_to_add_to.push_back(valves_to_open[idx]);
-				}
-				const bool low_is_longer = low_valves.size() > high_valves.size();
-				const utils::sorted_vector<ValveId>& longer = low_is_longer ? low_valves : high_valves;
-				const utils::sorted_vector<ValveId>& shorter = low_is_longer ? high_valves : low_valves;
-				const FlowTotal long_result = get_best_possible_flow(valves, starting_location, longer, time, 0);
-				const FlowTotal cut_off = best_result - long_result;
-				const FlowTotal short_result = get_best_possible_flow(valves, starting_location, shorter, time, cut_off);
-				const FlowTotal this_result = long_result + short_result;
-				best_result = std::max(best_result, this_result);
-			}
-			return best_result;
+					const advent::cancellation_scope cancellation{ token };
+					utils::sorted_vector<ValveId> low_valves, high_valves;
+					for (MaskType mask : utils::int_range{ first_mask, last_mask })
+					{
+						ADVENT_TRACE_SCOPE("split");
+						advent::check_cancellation();
+						low_valves.clear();
+						high_valves.clear();
+						for (auto idx : utils::int_range{ valves_to_open.size() })
+						{
+							const MaskType bit = MaskType{ 1u } << idx;
+							const MaskType mask_bit = mask & bit;
+							const bool is_high = mask_bit != 0;
+							utils::sorted_vector<ValveId>& valves_to_add_to = (is_high ? high_valves : low_valves);
+							valves_to_add_to.push_back(valves_to_open[idx]);
+						}
+						const bool low_is_longer = low_valves.size() > high_valves.size();
+						const utils::sorted_vector<ValveId>& longer = low_is_longer ? low_valves : high_valves;
+						const utils::sorted_vector<ValveId>& shorter = low_is_longer ? high_valves : low_valves;
+						const FlowTotal long_result = get_best_possible_flow(valves, starting_location, longer, time, 0, false);
+						const FlowTotal cut_off = best_result - long_result;
+						const FlowTotal short_result = get_best_possible_flow(valves, starting_location, shorter, time, cut_off, false);
+						const FlowTotal this_result = long_result + short_result;
+						FlowTotal previous_best = best_result;
+						while (this_result > previous_best && !best_result.compare_exchange_weak(previous_best, this_result))
+						{
+						}
+					}
+				});
+			return best_result.load();
 		}
 		AdventUnreachable();
 		return 0;
 	}
 
+	FlowTotal solve_p1(const ValveNetwork& network)
+	{
+		return solve_generic<AdventDay::One>(network, 30);
+	}
+
+	FlowTotal solve_p2(const ValveNetwork& network)
+	{
+		return solve_generic<AdventDay::Two>(network, 26);
+	}
+
 	FlowTotal solve_p1(std::istream& input)
 	{
-		return solve_generic<AdventDay::One>(input, "AA", 30);
+		return solve_p1(prepare_network(input, "AA"));
 	}
 
 	int solve_p2(std::istream& input)
 	{
-		return solve_generic<AdventDay::Two>(input, "AA", 26);
+		return solve_p2(prepare_network(input, "AA"));
+	}
+
+	BothPartsResult solve_both(std::istream& input)
+	{
+		const ValveNetwork network = prepare_network(input, "AA");
+		return BothPartsResult{ solve_p1(network), solve_p2(network) };
 	}
 }
 
@@ -551,6 +616,12 @@ ResultType day_sixteen_p2_a()
 	return solve_p2(input);
 }
 
+BothPartsResult day_sixteen_both_a()
+{
+	auto input = advent::open_testcase_input(16, 'a');
+	return solve_both(input);
+}
+
 ResultType advent_sixteen_p1()
 {
 	auto input = advent::open_puzzle_input(16);
@@ -563,5 +634,11 @@ ResultType advent_sixteen_p2()
 	return solve_p2(input);
 }
 
+BothPartsResult advent_sixteen_both()
+{
+	auto input = advent::open_puzzle_input(16);
+	return solve_both(input);
+}
+
 #undef DAY16DBG
 #undef ENABLE_DAY16DBG
\ No newline at end of file
@@ -4,6 +4,8 @@
 
 ResultType day_sixteen_p1_a();
 ResultType day_sixteen_p2_a();
+BothPartsResult day_sixteen_both_a();
 
 ResultType advent_sixteen_p1();
-ResultType advent_sixteen_p2();
\ No newline at end of file
+ResultType advent_sixteen_p2();
+BothPartsResult advent_sixteen_both();
\ No newline at end of file
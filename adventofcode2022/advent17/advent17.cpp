@@ -15,9 +15,9 @@
 namespace
 {
 #if DAY17DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
@@ -796,7 +796,9 @@ namespace
 
 	int64_t solve_p1(std::istream& input)
 	{
+		advent::phase_timer phase{ "parse" };
 		const std::string line = to_string(input);
+		phase.next("solve");
 		return solve_p1(line);
 	}
 }
@@ -810,8 +812,10 @@ namespace
 
 	int64_t solve_p2(std::istream& input)
 	{
+		advent::phase_timer phase{ "parse" };
 		const std::string line = to_string(input);
-		return solve_p2(line);;
+		phase.next("solve");
+		return solve_p2(line);
 	}
 }
 
@@ -15,9 +15,9 @@
 namespace
 {
 #if DAY18DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
@@ -126,7 +126,9 @@ namespace
 
 	int solve_p1(std::istream& input)
 	{
+		advent::phase_timer phase{ "parse" };
 		DropletMap droplets = parse_droplet_map(input, 6);
+		phase.next("solve");
 		droplets = set_exposed_faces_p1(std::move(droplets));
 		const int result = count_exposed_faces(droplets);
 		return result;
@@ -248,7 +250,9 @@ namespace
 
 	int solve_p2(std::istream& input)
 	{
+		advent::phase_timer phase{ "parse" };
 		DropletMap droplets = parse_droplet_map(input, 0);
+		phase.next("solve");
 		droplets = set_exposed_faces_p2(std::move(droplets));
 		const int result = count_exposed_faces(droplets);
 		return result;
@@ -15,9 +15,9 @@
 namespace
 {
 #if DAY19DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
@@ -25,13 +25,15 @@ namespace
 #include "parse_utils.h"
 #include "trim_string.h"
 #include "small_vector.h"
+#include "arena_resource.h"
 #include "string_line_iterator.h"
 #include "to_value.h"
 #include "int_range.h"
 #include "swap_remove.h"
 #include "comparisons.h"
+#include "thread_pool.h"
 
-#include <future>
+#include <deque>
 
 namespace
 {
@@ -286,13 +288,15 @@ namespace
 				});
 			return result;
 		}();
-		std::vector<MiningState> current_states{ initial_state };
-		std::vector<MiningState> next_states;
+		const utils::scratch_scope scratch;
+		std::pmr::vector<MiningState> current_states{ { initial_state }, scratch.resource() };
+		std::pmr::vector<MiningState> next_states{ scratch.resource() };
 		for (auto min : utils::int_range{ time_to_mine_for })
 		{
 			std::size_t num_skipped = 0;
 			for (const MiningState& state : current_states)
 			{
+				advent::check_cancellation();
 				MiningState next_state = state;
 				for (RockType type : ROCK_TYPE_ARRAY)
 				{
@@ -374,24 +378,30 @@ namespace
 	ResultType solve_generic(std::istream& input, int time_to_mine_for, int num_blueprints, int init_value, auto eval_func, auto combo_func)
 	{
 		using ILI = utils::istream_line_iterator;
-		using FutureType = std::future<int>;
 		ILI it{ input };
-		std::vector<FutureType> async_results;
 
-		auto func = [time_to_mine_for, &eval_func](Blueprint blueprint) -> int
-		{
-			return eval_func(blueprint, time_to_mine_for);
-		};
+		// Deque elements never move, so each task can hold on to where its result goes.
+		std::deque<int> results;
+		utils::task_group blueprint_tasks;
+
+		// Blueprints run on the pool, so hand this test's time budget on to them.
+		const advent::cancellation_token token = advent::get_cancellation_token();
 
+		// Blueprints start solving as soon as they are parsed, so "parse" overlaps with the first searches.
+		advent::phase_timer phase{ "parse" };
 		for (int i = 0; i < num_blueprints && it != ILI{}; ++i, ++it)
 		{
-			FutureType fut = std::async(std::launch::async, func, Blueprint{ *it });
-			async_results.emplace_back(std::move(fut));
+			int& result = results.emplace_back();
+			blueprint_tasks.run([&result, time_to_mine_for, &eval_func, token, blueprint = Blueprint{ *it }]()
+				{
+					const advent::cancellation_scope cancellation{ token };
+					result = eval_func(blueprint, time_to_mine_for);
+				});
 		}
+		phase.next("solve");
+		blueprint_tasks.wait();
 
-		const int result = std::transform_reduce(begin(async_results), end(async_results), init_value,
-			combo_func, [](FutureType& ft) { return ft.get(); });
-
+		const int result = std::accumulate(begin(results), end(results), init_value, combo_func);
 		return result;
 	}
 
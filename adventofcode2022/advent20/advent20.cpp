@@ -15,9 +15,9 @@
 namespace
 {
 #if DAY20DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
@@ -27,6 +27,7 @@ namespace
 #include "int_range.h"
 #include "range_contains.h"
 #include "istream_line_iterator.h"
+#include "string_line_iterator.h"
 #include "to_value.h"
 
 namespace
@@ -111,7 +112,8 @@ namespace
 		}
 	}
 
-	MessageType get_message(std::istream& input, ValType decryption_key)
+	template <typename LineIt>
+	MessageType get_message(LineIt first, LineIt last, ValType decryption_key)
 	{
 		auto decrypt_value = [decryption_key](std::string_view line)
 		{
@@ -121,10 +123,8 @@ namespace
 			return result;
 		};
 
-		using ItType = utils::istream_line_iterator;
-
 		MessageType result;
-		std::transform(ItType{ input }, ItType{}, std::back_inserter(result), decrypt_value);
+		std::transform(first, last, std::back_inserter(result), decrypt_value);
 
 		constexpr IdxType zero_idx{ 0 };
 		const IdxType message_len = size(result);
@@ -257,21 +257,39 @@ namespace
 		return get_coordinates_generic(message, std::array<IdxType,3>{1000, 2000, 3000});
 	}
 
-	ValType solve_generic(std::istream& input, ValType decryption_key, int num_times_to_mix)
+	MessageType get_message(std::istream& input, ValType decryption_key)
+	{
+		using ILI = utils::istream_line_iterator;
+		return get_message(ILI{ input }, ILI{}, decryption_key);
+	}
+
+	// Works directly on the mapped input, so no line is ever copied.
+	MessageType get_message(std::string_view input, ValType decryption_key)
 	{
+		using SLI = utils::string_line_iterator;
+		return get_message(SLI{ input }, SLI{}, decryption_key);
+	}
+
+	template <typename InputType>
+	ValType solve_generic(InputType&& input, ValType decryption_key, int num_times_to_mix)
+	{
+		advent::phase_timer phase{ "parse" };
 		MessageType message = get_message(input, decryption_key);
+		phase.next("solve");
 		message = mix(std::move(message), num_times_to_mix);
 		const ValType result = get_grove_coordinates(message);
 		return result;
 	}
 
-	ValType solve_p1(std::istream& input)
+	template <typename InputType>
+	ValType solve_p1(InputType&& input)
 	{
 		const ValType result = solve_generic(input, 1, 1);
 		return result;
 	}
 
-	ValType solve_p2(std::istream& input)
+	template <typename InputType>
+	ValType solve_p2(InputType&& input)
 	{
 		constexpr ValType decryption_key = 811589153;
 		constexpr int num_times_to_mix = 10;
@@ -305,13 +323,13 @@ ResultType day_twenty_p2_a()
 ResultType advent_twenty_p1()
 {
 	auto input = advent::open_puzzle_input(20);
-	return solve_p1(input);
+	return input.is_streaming() ? solve_p1(input) : solve_p1(input.view());
 }
 
 ResultType advent_twenty_p2()
 {
 	auto input = advent::open_puzzle_input(20);
-	return solve_p2(input);
+	return input.is_streaming() ? solve_p2(input) : solve_p2(input.view());
 }
 
 #undef DAY20DBG
@@ -15,9 +15,9 @@
 namespace
 {
 #if DAY21DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
@@ -388,7 +388,9 @@ namespace
 	int64_t solve_p1(std::istream& input)
 	{
 		const Monkey root_monkey{ ROOT_ID };
+		advent::phase_timer phase{ "parse" };
 		SolutionState solution_state = read_file<AdventDay::One>(input);
+		phase.next("solve");
 		const Value result = solve_for_value(std::move(solution_state), root_monkey);
 		return result;
 	}
@@ -398,7 +400,9 @@ namespace
 {
 	int64_t solve_p2(std::istream& input)
 	{
+		advent::phase_timer phase{ "parse" };
 		SolutionState initial_state = read_file<AdventDay::Two>(input);
+		phase.next("solve");
 		const Monkey human{ HUMAN_ID };
 		const Value result = solve_for_value(std::move(initial_state), human);
 		return result;
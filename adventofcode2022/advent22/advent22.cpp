@@ -15,9 +15,9 @@
 namespace
 {
 #if DAY22DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
@@ -288,7 +288,8 @@ namespace
 		{
 			const int line_len = line.get_num_walkable();
 			auto forward_wall_it = line.walls.lower_bound(start_coord);
-			AdventCheck(*forward_wall_it != start_coord);
+			// Past the last wall the iterator is at the end, and the modular index wraps that round to the first.
+			AdventCheck(forward_wall_it == end(line.walls) || *forward_wall_it != start_coord);
 			utils::modular wall_idx{ std::distance(begin(line.walls),forward_wall_it), std::ssize(line.walls)};
 			if (!is_going_forwards) --wall_idx;
 			int wall_location = line.walls[wall_idx];
@@ -339,11 +340,25 @@ namespace
 		return result;
 	}
 
-	int solve_p1(std::istream& input)
+	struct Notes
+	{
+		State start;
+		Path path;
+	};
+
+	Notes parse_notes(std::istream& input)
+	{
+		advent::phase_timer phase{ "parse" };
+		Notes result;
+		result.start = parse_state(input);
+		result.path = parse_path(input);
+		return result;
+	}
+
+	int solve_p1(Notes notes)
 	{
-		State state = parse_state(input);
-		const Path path = parse_path(input);
-		const State result = follow_path(std::move(state), path);
+		advent::phase_timer phase{ "solve" };
+		const State result = follow_path(std::move(notes.start), notes.path);
 		const int password = get_password(result.position);
 		log << "\nFinal location=[" << result.position.location << "] "
 			"heading=" << result.position.heading << 
@@ -351,10 +366,30 @@ namespace
 		return password;
 	}
 
-	int solve_p2(std::istream& input)
+	int solve_p2(const Notes& notes)
 	{
 		return 0;
 	}
+
+	int solve_p1(std::istream& input)
+	{
+		return solve_p1(parse_notes(input));
+	}
+
+	int solve_p2(std::istream& input)
+	{
+		return solve_p2(parse_notes(input));
+	}
+
+	BothPartsResult solve_both(std::istream& input)
+	{
+		Notes notes = parse_notes(input);
+
+		// Part one walks the map it is given rather than copying it, so it goes last.
+		const int part_two = solve_p2(notes);
+		const int part_one = solve_p1(std::move(notes));
+		return BothPartsResult{ part_one, part_two };
+	}
 }
 
 ResultType day_twentytwo_p1_a()
@@ -369,6 +404,12 @@ ResultType day_twentytwo_p2_a()
 	return solve_p2(input);
 }
 
+BothPartsResult day_twentytwo_both_a()
+{
+	auto input = advent::open_testcase_input(22, 'a');
+	return solve_both(input);
+}
+
 ResultType advent_twentytwo_p1()
 {
 	auto input = advent::open_puzzle_input(22);
@@ -381,5 +422,11 @@ ResultType advent_twentytwo_p2()
 	return solve_p2(input);
 }
 
+BothPartsResult advent_twentytwo_both()
+{
+	auto input = advent::open_puzzle_input(22);
+	return solve_both(input);
+}
+
 #undef DAY22DBG
 #undef ENABLE_DAY22DBG
\ No newline at end of file
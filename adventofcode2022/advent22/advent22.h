@@ -4,6 +4,8 @@
 
 ResultType day_twentytwo_p1_a();
 ResultType day_twentytwo_p2_a();
+BothPartsResult day_twentytwo_both_a();
 
 ResultType advent_twentytwo_p1();
-ResultType advent_twentytwo_p2();
\ No newline at end of file
+ResultType advent_twentytwo_p2();
+BothPartsResult advent_twentytwo_both();
\ No newline at end of file
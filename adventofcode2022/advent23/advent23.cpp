@@ -15,18 +15,20 @@
 namespace
 {
 #if DAY23DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
 #include "coords.h"
 #include <vector>
 #include "sorted_vector.h"
+#include "arena_resource.h"
 #include <execution>
 #include "int_range.h"
 #include "range_contains.h"
+#include "conway_simulation.h"
 
 namespace
 {
@@ -172,10 +174,17 @@ namespace
 	struct ScratchArea
 	{
 	private:
-		std::vector<Coords> prop_coords;
-		AreaMap wip_map;
+		std::pmr::vector<Coords> prop_coords;
+		utils::sorted_vector<Coords, std::less<Coords>, 1, std::pmr::polymorphic_allocator<Coords>> wip_map;
+
+		// Swapped with the caller's map, so it has to use the same allocator.
 		AreaMap final_map;
 	public:
+		explicit ScratchArea(std::pmr::memory_resource* resource)
+			: prop_coords{ resource }
+			, wip_map{ std::pmr::polymorphic_allocator<Coords>{ resource } }
+		{}
+
 		void reset(std::size_t capacity)
 		{
 			auto do_reset = [capacity](auto& thing)
@@ -253,10 +262,13 @@ namespace
 	SimulateResult simulate(std::istream& input, int max_moves = std::numeric_limits<int>::max())
 	{
 		SimulateResult result;
+		advent::phase_timer phase{ "parse" };
 		result.final_map = parse_area(input);
 		result.num_moves = max_moves;
+		phase.next("solve");
 
-		ScratchArea scratch_area;
+		const utils::scratch_scope scratch;
+		ScratchArea scratch_area{ scratch.resource() };
 		std::array<Dir, 4> search_pattern{ Dir::up, Dir::down, Dir::left, Dir::right };
 		for (auto i : utils::int_range{ max_moves })
 		{
@@ -349,6 +361,40 @@ ResultType day_twentythree_p2_b()
 	return solve_p2(input);
 }
 
+// Not this day's puzzle, but the same kind of simulation: runs a Game of Life glider through
+// utils::conway_simulation, so that its tick() is compiled and checked. Every four ticks a glider
+// takes its starting shape again, one cell further on diagonally, so after 28 it has moved by (7,7).
+ResultType day_twentythree_conway_glider()
+{
+	const std::array<Coords, 5> glider{ Coords{ 1,0 }, Coords{ 2,1 }, Coords{ 0,2 }, Coords{ 1,2 }, Coords{ 2,2 } };
+	auto update = [](const Coords&, bool is_on, std::size_t num_neighbours_on)
+	{
+		return num_neighbours_on == 3 || (is_on && num_neighbours_on == 2);
+	};
+	auto gather = [](const Coords& cell)
+	{
+		std::vector<Coords> result;
+		for (int dy = -1; dy <= 1; ++dy)
+		{
+			for (int dx = -1; dx <= 1; ++dx)
+			{
+				if (dx != 0 || dy != 0)
+				{
+					result.push_back(cell + Coords{ dx,dy });
+				}
+			}
+		}
+		return result;
+	};
+	utils::conway_simulation::state<Coords, decltype(update), decltype(gather)> simulation{ begin(glider), end(glider), update, gather };
+	simulation.tick_n_times(28);
+	AdventCheck(simulation.number_of_cells_on() == glider.size());
+	return std::ranges::count_if(glider, [&simulation](const Coords& cell)
+		{
+			return simulation.is_cell_on(cell + Coords{ 7,7 });
+		});
+}
+
 ResultType advent_twentythree_p1()
 {
 	auto input = advent::open_puzzle_input(23);
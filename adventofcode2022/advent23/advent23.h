@@ -6,6 +6,7 @@ ResultType day_twentythree_p1_a();
 ResultType day_twentythree_p1_b();
 ResultType day_twentythree_p2_a();
 ResultType day_twentythree_p2_b();
+ResultType day_twentythree_conway_glider();
 
 ResultType advent_twentythree_p1();
 ResultType advent_twentythree_p2();
\ No newline at end of file
@@ -15,9 +15,9 @@
 namespace
 {
 #if DAY24DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
@@ -504,6 +504,7 @@ namespace
 
 	int find_route_length(const Map& map, int start_minute, bool is_reversed)
 	{
+		ADVENT_TRACE_SCOPE("find_route_length");
 		struct Node
 		{
 			coords location;
@@ -532,6 +533,7 @@ namespace
 
 		while (!unsearched_nodes.empty())
 		{
+			advent::check_cancellation();
 			const auto get_heuristic = [](const Node& n) { return n.heuristic; };
 			const auto node_to_check_it = utils::ranges::min_element_transform(unsearched_nodes, get_heuristic);
 			AdventCheck(node_to_check_it != end(unsearched_nodes));
@@ -553,6 +555,11 @@ namespace
 			if (previously_checked != end(searched_nodes)) continue;
 
 			searched_nodes.push_back(node_to_check);
+			if (searched_nodes.size() % 1024 == 0)
+			{
+				ADVENT_TRACE_COUNTER("day24 nodes to search", unsearched_nodes.size());
+				ADVENT_TRACE_COUNTER("day24 time", node_to_check.time);
+			}
 
 			const auto neighbours = node_to_check.location.neighbours();
 			const int new_time = node_to_check.time + 1;
@@ -568,20 +575,32 @@ namespace
 		return -1;
 	}
 
-	int solve_generic(std::istream& input, int times_across)
+	std::unique_ptr<Map> parse_valley(std::istream& input)
 	{
-		const std::unique_ptr<Map> map = parse_map(input);
-		if (map.get() == nullptr)
+		advent::phase_timer phase{ "parse" };
+		return parse_map(input);
+	}
+
+	// Crosses the valley times_across times, starting from the end of the first times_done crossings.
+	int cross_valley(const Map& map, int start_minute, int times_done, int times_across)
+	{
+		advent::phase_timer phase{ "solve" };
+		int total_time = start_minute;
+		for (int i : utils::int_range(times_done, times_across))
 		{
-			return -1;
+			total_time = find_route_length(map, total_time, i % 2);
 		}
+		return total_time;
+	}
 
-		int total_time = 0;
-		for (int i : utils::int_range(times_across))
+	int solve_generic(std::istream& input, int times_across)
+	{
+		const std::unique_ptr<Map> map = parse_valley(input);
+		if (map.get() == nullptr)
 		{
-			total_time = find_route_length(*map, total_time, i % 2);
+			return -1;
 		}
-		return total_time;
+		return cross_valley(*map, 0, 0, times_across);
 	}
 
 	int solve_p1(std::istream& input)
@@ -596,6 +615,19 @@ namespace
 	{
 		return solve_generic(input, 3);
 	}
+
+	// Part two's first crossing is part one, so its answer comes for free along the way.
+	BothPartsResult solve_both(std::istream& input)
+	{
+		const std::unique_ptr<Map> map = parse_valley(input);
+		if (map.get() == nullptr)
+		{
+			return BothPartsResult{ -1, -1 };
+		}
+		const int part_one = cross_valley(*map, 0, 0, 1);
+		const int part_two = cross_valley(*map, part_one, 1, 3);
+		return BothPartsResult{ part_one, part_two };
+	}
 }
 
 namespace
@@ -640,6 +672,12 @@ ResultType advent_twentyfour_p2()
 	return solve_p2(input);
 }
 
+BothPartsResult advent_twentyfour_both()
+{
+	auto input = advent::open_puzzle_input(24);
+	return solve_both(input);
+}
+
 ResultType day_twentyfour_p1_a()
 {
 	auto input = testcase_a();
@@ -664,5 +702,17 @@ ResultType day_twentyfour_p2_b()
 	return solve_p2(input);
 }
 
+BothPartsResult day_twentyfour_both_a()
+{
+	auto input = testcase_a();
+	return solve_both(input);
+}
+
+BothPartsResult day_twentyfour_both_b()
+{
+	auto input = testcase_b();
+	return solve_both(input);
+}
+
 #undef DAY24DBG
 #undef ENABLE_DAY24DBG
\ No newline at end of file
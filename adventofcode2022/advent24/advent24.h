@@ -6,6 +6,9 @@ ResultType day_twentyfour_p1_a();
 ResultType day_twentyfour_p1_b();
 ResultType day_twentyfour_p2_a();
 ResultType day_twentyfour_p2_b();
+BothPartsResult day_twentyfour_both_a();
+BothPartsResult day_twentyfour_both_b();
 
 ResultType advent_twentyfour_p1();
-ResultType advent_twentyfour_p2();
\ No newline at end of file
+ResultType advent_twentyfour_p2();
+BothPartsResult advent_twentyfour_both();
\ No newline at end of file
@@ -15,13 +15,14 @@
 namespace
 {
 #if DAY25DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
 #include <istream_line_iterator.h>
+#include <string_line_iterator.h>
 #include <numeric>
 
 namespace
@@ -84,11 +85,24 @@ namespace
 		return result;
 	}
 
+	template <typename LineIt>
+	std::string solve_p1(LineIt first, LineIt last)
+	{
+		const Decimal sum = std::transform_reduce(first, last, Decimal{ 0 }, std::plus<Decimal>{}, snafu_to_decimal);
+		return decimal_to_snafu(sum);
+	}
+
 	std::string solve_p1(std::istream& input)
 	{
 		using ILI = utils::istream_line_iterator;
-		const Decimal sum = std::transform_reduce(ILI{ input }, ILI{}, Decimal{ 0 }, std::plus<Decimal>{}, snafu_to_decimal);
-		return decimal_to_snafu(sum);
+		return solve_p1(ILI{ input }, ILI{});
+	}
+
+	// Works directly on the mapped input, so no line is ever copied.
+	std::string solve_p1(std::string_view input)
+	{
+		using SLI = utils::string_line_iterator;
+		return solve_p1(SLI{ input }, SLI{});
 	}
 
 	std::istringstream testcase_a()
@@ -153,7 +167,7 @@ ResultType day_twentyfive_p1_a()
 ResultType advent_twentyfive_p1()
 {
 	auto input = advent::open_puzzle_input(25);
-	return solve_p1(input);
+	return input.is_streaming() ? solve_p1(input) : solve_p1(input.view());
 }
 
 ResultType advent_twentyfive_p2()
@@ -15,9 +15,9 @@
 namespace
 {
 #if DAY5DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
@@ -209,8 +209,10 @@ namespace
 	template <AdventDay Day>
 	CrateWarehouse get_moved_warehouse(std::istream& input)
 	{
+		advent::phase_timer phase{ "parse" };
 		CrateWarehouse result;
 		result.create_from_istream(input);
+		phase.next("solve");
 		result = move_crates_around<Day>(std::move(result),input);
 		return result;
 	}
@@ -15,9 +15,9 @@
 namespace
 {
 #if DAY7DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
@@ -28,6 +28,7 @@ namespace
 #include <algorithm>
 
 #include "istream_line_iterator.h"
+#include "string_line_iterator.h"
 #include "split_string.h"
 #include "trim_string.h"
 #include "parse_utils.h"
@@ -176,15 +177,17 @@ namespace
 		return result;
 	}
 
-	Directory get_directory_structure(std::istream& input)
+	template <typename LineIt>
+	Directory get_directory_structure(LineIt first, LineIt last)
 	{
 		Directory result;
 		result.name = std::string{ root_folder };
 		Directory* working_directory = nullptr;
 		bool expects_user_input = true;
 
-		for (const std::string_view line : utils::istream_line_range{input})
+		for (; first != last; ++first)
 		{
+			const std::string_view line = *first;
 			const Command command = read_as_command(line);
 
 			switch (command.command_type)
@@ -234,6 +237,19 @@ namespace
 		return result;
 	}
 
+	Directory get_directory_structure(std::istream& input)
+	{
+		using ILI = utils::istream_line_iterator;
+		return get_directory_structure(ILI{ input }, ILI{});
+	}
+
+	// Works directly on the mapped input, so no line is ever copied.
+	Directory get_directory_structure(std::string_view input)
+	{
+		using SLI = utils::string_line_iterator;
+		return get_directory_structure(SLI{ input }, SLI{});
+	}
+
 	void print_directory(std::ostream& output, const Directory& dir, int depth = 0)
 	{
 		auto add_prefix = [&output, depth]()
@@ -275,9 +291,12 @@ namespace
 		return subdir_result + (folder_size <= threshold ? folder_size : FileSize{ 0 });
 	}
 
-	FileSize solve_p1(std::istream& input)
+	template <typename InputType>
+	FileSize solve_p1(InputType&& input)
 	{
+		advent::phase_timer phase{ "parse" };
 		const Directory dir = get_directory_structure(input);
+		phase.next("solve");
 		return solve_p1_generic(dir, p1_threshold);
 	}
 }
@@ -325,9 +344,12 @@ namespace
 		return get_size_of_smallest_folder_at_least(dir, min_free_size);
 	}
 
-	FileSize solve_p2(std::istream& input)
+	template <typename InputType>
+	FileSize solve_p2(InputType&& input)
 	{
+		advent::phase_timer phase{ "parse" };
 		const Directory dir = get_directory_structure(input);
+		phase.next("solve");
 		return solve_p2(dir, total_space, required_space);
 	}
 }
@@ -379,13 +401,13 @@ ResultType day_seven_p2_a()
 ResultType advent_seven_p1()
 {
 	auto input = advent::open_puzzle_input(7);
-	return solve_p1(input);
+	return input.is_streaming() ? solve_p1(input) : solve_p1(input.view());
 }
 
 ResultType advent_seven_p2()
 {
 	auto input = advent::open_puzzle_input(7);
-	return solve_p2(input);
+	return input.is_streaming() ? solve_p2(input) : solve_p2(input.view());
 }
 
 #undef DAY7DBG
@@ -15,9 +15,9 @@
 namespace
 {
 #if DAY8DBG
-	std::ostream & log = std::cout;
+	std::ostream & log = advent::debug_log();
 #else
-	struct {	template <typename T> auto& operator<<(const T&) const noexcept { return *this; } } log;
+	advent::null_log log;
 #endif
 }
 
@@ -179,7 +179,9 @@ namespace
 
 	int solve_p1(std::istream& input)
 	{
+		advent::phase_timer phase{ "parse" };
 		Grid grid{ input };
+		phase.next("solve");
 		grid = mark_visible_trees(std::move(grid));
 		const auto result = std::ranges::count_if(grid, [](Node n) {return n.is_visible; });
 		return static_cast<int>(result);
@@ -285,7 +287,9 @@ namespace
 
 	int solve_p2(std::istream& input)
 	{
+		advent::phase_timer phase{ "parse" };
 		Grid grid{ input };
+		phase.next("solve");
 		grid = mark_all_visibilities(std::move(grid));
 		const Node& result = utils::ranges::max_transform(grid, [](const Node& n) {return n.visibility_rating; });
 		return result.visibility_rating;
@@ -1,6 +1,84 @@
 #include "advent/advent_of_code.h"
+#include "advent/advent_generators.h"
+#include "advent/advent_scaling.h"
+#include "advent/advent_daemon.h"
+#include "advent/advent_batch.h"
+#include "advent/advent_solvers.h"
+#include "advent/advent_results.h"
+#include "utils/thread_pool.h"
 
 #include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cstdlib>
+#include <string_view>
+#include <string>
+#include <thread>
+#include <iterator>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
+
+namespace
+{
+	// Prints the answers to one input read from source, which is a file or "-" for stdin.
+	int solve_from_source(int day, int part, const std::string& source, std::chrono::milliseconds timeout)
+	{
+		std::ifstream file;
+		std::istream* input = &std::cin;
+		if (source == "-")
+		{
+			std::ios::sync_with_stdio(false);
+		}
+		else
+		{
+			file.open(source, std::ios::binary);
+			if (!file.is_open())
+			{
+				std::cerr << "Could not open input file " << source << '\n';
+				return 1;
+			}
+			input = &file;
+		}
+
+		std::vector<advent::solve_outcome> outcomes;
+		if (part == 0)
+		{
+			// Most days read the input once per part, so it has to be kept for the second.
+			const std::string text{ std::istreambuf_iterator<char>{ *input }, std::istreambuf_iterator<char>{} };
+			const auto both = advent::solve_both_input(day, text, timeout);
+			outcomes.assign(begin(both), end(both));
+		}
+		else
+		{
+			outcomes.push_back(advent::solve_stream(day, part, *input, timeout));
+		}
+
+		bool success = true;
+		for (const advent::solve_outcome& outcome : outcomes)
+		{
+			switch (outcome.status)
+			{
+			case advent::solve_status::ok:
+				std::cout << outcome.result << '\n';
+				break;
+			case advent::solve_status::timeout:
+				std::cerr << "Timed out after " << to_human_readable(outcome.time) << '\n';
+				success = false;
+				break;
+			case advent::solve_status::error:
+				std::cerr << outcome.error << '\n';
+				success = false;
+				break;
+			}
+			if (!success) break;
+		}
+		return success ? 0 : 1;
+	}
+}
 
 int main(int argc, char** argv)
 {
@@ -10,13 +88,250 @@ int main(int argc, char** argv)
 	// and advent_eighteen_p2() (as well as any other test functions with "eighteen"
 	// in the function name.
 	// Leave blank to run everything.
-	if (argc > 1)
+	//
+	// Options:
+	//   --jobs N       Run N tests at once, slowest first. 0 uses one job per hardware thread.
+	//   --threads N    Threads shared by parallel tests and days' own parallel work. Default: one per hardware thread.
+	//   --timings FILE Read and write previous test timings here. Leave FILE blank to disable.
+	//                  Defaults to test_timings.txt with --jobs, so parallel runs start the slowest tests first.
+	//   --bench        Benchmark each test: 3 warmup runs then the median of at least 30 runs.
+	//   --warmup N     Untimed runs of each test before timing starts.
+	//   --repeat N     Timed runs of each test.
+	//   --min-time MS  Keep repeating each test until it has been timed for at least MS milliseconds.
+	//   --json FILE    Also write the results to FILE as JSON lines.
+	//   --csv FILE     Also write the results to FILE as CSV.
+	//   --baseline FILE       Fail if any test's median is significantly slower than in FILE.
+	//   --threshold Z         Standard errors of slowdown that count as a regression. Default 3.
+	//   --min-slowdown PCT    Smallest slowdown, in percent of the baseline median, that counts as a regression. Default 5.
+	//   --save-baseline FILE  Write this run's timings to FILE for later comparison.
+	//   --counters     Report hardware performance counters for each test's own thread (Linux only).
+	//   --trace FILE   Write a Chrome trace-event timeline of the run to FILE (not in release builds).
+	//   --timeout MS   Give up on any test still running after MS milliseconds.
+	//   --pin-core N   Run the tests on logical core N only, for steadier timings. Needs --jobs 1;
+	//                  add --threads 1 to keep days' parallel work on the core too.
+	//   --high-priority  Run the tests at raised scheduling priority (usually needs admin or root).
+	//
+	//   --generate DAY SIZE FILE  Write a generated input for DAY to FILE instead of running tests.
+	//                             What SIZE counts depends on the day (elves for day 1, and so on).
+	//   --seed N                  Seed for --generate. The same seed always gives the same input.
+	//
+	//   --scaling          Instead of the tests, time each solver on generated inputs of doubling size
+	//                      and report how its time grows. The filter and --seed apply.
+	//   --scaling-sizes N  Number of sizes to try per solver. Default 6.
+	//
+	//   --daemon       Instead of the tests, solve jobs read from stdin and write answers to stdout,
+	//                  one JSON line each, until stdin closes. --timeout applies to each job.
+	//                  See advent_daemon.h for the job format.
+	//
+	//   --batch DAY PART DIR  Instead of the tests, solve every input in DIR for DAY in parallel and report
+	//                         inputs per second and latency. PART 0 solves both parts from one parse. --threads and
+	//                         --timeout apply, and --json FILE gets each input's answers.
+	//
+	//   --solve DAY PART FILE  Instead of the tests, print the answer to one input read from FILE, or from
+	//                         stdin if FILE is -. Days that read a line at a time solve the input as it
+	//                         arrives. PART 0 prints both parts, but reads all of the input first.
+	//                         --timeout applies.
+	//
+	// The exit code is nonzero if any test fails, times out or regresses.
+	verification_options options;
+	int generate_day = 0;
+	std::size_t generate_size = 0;
+	std::string generate_file;
+	std::uint64_t generate_seed = 0;
+	bool run_scaling = false;
+	bool run_as_daemon = false;
+	batch_options batch;
+	int solve_day = 0;
+	int solve_part = 0;
+	std::string solve_source;
+	scaling_options scaling;
+	bool timings_file_given = false;
+	for (int i = 1; i < argc; ++i)
 	{
-		verify_all(argv[1]);
+		const std::string_view arg{ argv[i] };
+		auto get_next_arg = [&i, argc, argv, arg]()
+		{
+			if (i + 1 >= argc)
+			{
+				std::cerr << "Missing value for " << arg << '\n';
+				std::exit(1);
+			}
+			return std::string{ argv[++i] };
+		};
+
+		if (arg == "--jobs" || arg == "-j")
+		{
+			options.num_jobs = std::stoi(get_next_arg());
+			if (options.num_jobs <= 0)
+			{
+				options.num_jobs = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u));
+			}
+		}
+		else if (arg == "--threads")
+		{
+			utils::set_thread_count(static_cast<std::size_t>(std::max(std::stoi(get_next_arg()), 1)));
+		}
+		else if (arg == "--timings")
+		{
+			options.timings_file = get_next_arg();
+			timings_file_given = true;
+		}
+		else if (arg == "--bench")
+		{
+			options.warmup_iterations = 3;
+			options.benchmark_iterations = 30;
+		}
+		else if (arg == "--warmup")
+		{
+			options.warmup_iterations = std::stoi(get_next_arg());
+		}
+		else if (arg == "--repeat")
+		{
+			options.benchmark_iterations = std::stoi(get_next_arg());
+		}
+		else if (arg == "--min-time")
+		{
+			options.benchmark_min_time = std::chrono::milliseconds{ std::stoi(get_next_arg()) };
+		}
+		else if (arg == "--json")
+		{
+			options.json_output_file = get_next_arg();
+		}
+		else if (arg == "--csv")
+		{
+			options.csv_output_file = get_next_arg();
+		}
+		else if (arg == "--baseline")
+		{
+			options.baseline_file = get_next_arg();
+		}
+		else if (arg == "--threshold")
+		{
+			options.regression_threshold = std::stod(get_next_arg());
+		}
+		else if (arg == "--min-slowdown")
+		{
+			options.regression_min_slowdown = std::stod(get_next_arg()) / 100.0;
+		}
+		else if (arg == "--save-baseline")
+		{
+			options.save_baseline_file = get_next_arg();
+		}
+		else if (arg == "--counters")
+		{
+			options.collect_counters = true;
+		}
+		else if (arg == "--trace")
+		{
+			options.trace_file = get_next_arg();
+		}
+		else if (arg == "--pin-core")
+		{
+			options.pin_to_core = std::stoi(get_next_arg());
+		}
+		else if (arg == "--high-priority")
+		{
+			options.raise_priority = true;
+		}
+		else if (arg == "--timeout")
+		{
+			options.test_timeout = std::chrono::milliseconds{ std::stoi(get_next_arg()) };
+		}
+		else if (arg == "--generate")
+		{
+			generate_day = std::stoi(get_next_arg());
+			generate_size = std::stoull(get_next_arg());
+			generate_file = get_next_arg();
+		}
+		else if (arg == "--seed")
+		{
+			generate_seed = std::stoull(get_next_arg());
+		}
+		else if (arg == "--scaling")
+		{
+			run_scaling = true;
+		}
+		else if (arg == "--daemon")
+		{
+			run_as_daemon = true;
+		}
+		else if (arg == "--solve")
+		{
+			solve_day = std::stoi(get_next_arg());
+			solve_part = std::stoi(get_next_arg());
+			solve_source = get_next_arg();
+		}
+		else if (arg == "--batch")
+		{
+			batch.day = std::stoi(get_next_arg());
+			batch.part = std::stoi(get_next_arg());
+			batch.input_directory = get_next_arg();
+		}
+		else if (arg == "--scaling-sizes")
+		{
+			scaling.num_sizes = std::stoi(get_next_arg());
+		}
+		else
+		{
+			options.filter = arg;
+		}
+	}
+
+	if (generate_day != 0)
+	{
+		if (generate_day < advent::first_generated_day || generate_day > advent::last_generated_day)
+		{
+			std::cerr << "There is no input generator for day " << generate_day << '\n';
+			return 1;
+		}
+		std::ofstream file{ generate_file, std::ios::binary };
+		if (!file.is_open())
+		{
+			std::cerr << "Could not write input to " << generate_file << '\n';
+			return 1;
+		}
+		file << advent::generate_input(generate_day, generate_size, generate_seed);
+		std::cout << "Wrote day " << generate_day << " input with " << generate_size << ' '
+			<< advent::describe_input_scale(generate_day) << " to " << generate_file << '\n';
+		return 0;
 	}
-	else
+
+	if (run_as_daemon)
 	{
-		verify_all();
+#ifdef _WIN32
+		// Inline inputs are counted in bytes, so line endings must come through untranslated.
+		_setmode(_fileno(stdin), _O_BINARY);
+#endif
+		daemon_options daemon;
+		daemon.job_timeout = options.test_timeout;
+		return run_daemon(std::cin, std::cout, daemon) == 0 ? 0 : 1;
 	}
-	return 0;
+
+	if (solve_day != 0)
+	{
+		return solve_from_source(solve_day, solve_part, solve_source, options.test_timeout);
+	}
+
+	if (batch.day != 0)
+	{
+		batch.solve_timeout = options.test_timeout;
+		batch.results_file = options.json_output_file;
+		return run_batch(batch) ? 0 : 1;
+	}
+
+	if (run_scaling)
+	{
+		scaling.filter = options.filter;
+		scaling.seed = generate_seed;
+		return run_scaling_suite(scaling) ? 0 : 1;
+	}
+
+	// Only the parallel scheduler uses the timings, so serial runs leave the file alone unless asked.
+	if (options.num_jobs > 1 && !timings_file_given)
+	{
+		options.timings_file = "test_timings.txt";
+	}
+
+	const bool success = verify_all(options);
+	return success ? 0 : 1;
 }
\ No newline at end of file
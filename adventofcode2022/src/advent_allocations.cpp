@@ -0,0 +1,136 @@
+#include "../advent/advent_allocations.h"
+
+#if AOC_TRACK_ALLOCATIONS
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+
+namespace
+{
+	struct allocation_counters
+	{
+		std::size_t allocations;
+		std::size_t deallocations;
+		std::size_t bytes_allocated;
+		// Signed because memory allocated before tracking started can be freed during it.
+		long long live_bytes;
+		long long peak_live_bytes;
+	};
+
+	// Plain data only, so these are usable from operator new before anything else is set up.
+	thread_local allocation_counters this_thread_allocations;
+
+	// Stored just before every block so delete knows how much is being freed,
+	// and where the underlying malloc started for over-aligned blocks.
+	struct allocation_header
+	{
+		void* base;
+		std::size_t size;
+	};
+
+	void* tracked_allocate(std::size_t size, std::size_t alignment) noexcept
+	{
+		alignment = std::max(alignment, alignof(allocation_header));
+		void* const base = std::malloc(size + sizeof(allocation_header) + alignment);
+		if (base == nullptr)
+		{
+			return nullptr;
+		}
+		const std::uintptr_t first_free = reinterpret_cast<std::uintptr_t>(base) + sizeof(allocation_header);
+		const std::uintptr_t aligned = (first_free + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+		void* const result = reinterpret_cast<void*>(aligned);
+		allocation_header* const header = static_cast<allocation_header*>(result) - 1;
+		header->base = base;
+		header->size = size;
+
+		allocation_counters& counters = this_thread_allocations;
+		++counters.allocations;
+		counters.bytes_allocated += size;
+		counters.live_bytes += static_cast<long long>(size);
+		counters.peak_live_bytes = std::max(counters.peak_live_bytes, counters.live_bytes);
+		return result;
+	}
+
+	void tracked_deallocate(void* ptr) noexcept
+	{
+		if (ptr == nullptr)
+		{
+			return;
+		}
+		const allocation_header* const header = static_cast<allocation_header*>(ptr) - 1;
+		allocation_counters& counters = this_thread_allocations;
+		++counters.deallocations;
+		counters.live_bytes -= static_cast<long long>(header->size);
+		std::free(header->base);
+	}
+
+	void* tracked_allocate_or_throw(std::size_t size, std::size_t alignment)
+	{
+		while (true)
+		{
+			if (void* const result = tracked_allocate(size, alignment))
+			{
+				return result;
+			}
+			std::new_handler handler = std::get_new_handler();
+			if (handler == nullptr)
+			{
+				throw std::bad_alloc{};
+			}
+			handler();
+		}
+	}
+}
+
+void* operator new(std::size_t size) { return tracked_allocate_or_throw(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](std::size_t size) { return tracked_allocate_or_throw(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(std::size_t size, std::align_val_t align) { return tracked_allocate_or_throw(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align) { return tracked_allocate_or_throw(size, static_cast<std::size_t>(align)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return tracked_allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return tracked_allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return tracked_allocate(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return tracked_allocate(size, static_cast<std::size_t>(align)); }
+
+void operator delete(void* ptr) noexcept { tracked_deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { tracked_deallocate(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { tracked_deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { tracked_deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { tracked_deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { tracked_deallocate(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { tracked_deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { tracked_deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { tracked_deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { tracked_deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { tracked_deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { tracked_deallocate(ptr); }
+
+void advent::start_allocation_tracking()
+{
+	this_thread_allocations = allocation_counters{};
+}
+
+advent::allocation_stats advent::stop_allocation_tracking()
+{
+	const allocation_counters& counters = this_thread_allocations;
+	return allocation_stats{
+		counters.allocations,
+		counters.deallocations,
+		counters.bytes_allocated,
+		static_cast<std::size_t>(counters.peak_live_bytes)
+	};
+}
+
+#else
+
+void advent::start_allocation_tracking()
+{
+}
+
+advent::allocation_stats advent::stop_allocation_tracking()
+{
+	return allocation_stats{};
+}
+
+#endif
\ No newline at end of file
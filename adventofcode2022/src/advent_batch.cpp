@@ -0,0 +1,177 @@
+#include "../advent/advent_batch.h"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+#include "../advent/advent_solvers.h"
+#include "../advent/advent_results.h"
+#include "../advent/advent_assert.h"
+
+#include "../utils/mapped_file.h"
+#include "../utils/thread_pool.h"
+
+namespace
+{
+	struct batch_input
+	{
+		std::filesystem::path path;
+		std::vector<advent::solve_outcome> outcomes;
+
+		// From starting to read the input to finishing its last part.
+		std::chrono::nanoseconds latency{ 0 };
+	};
+
+	std::vector<batch_input> find_inputs(const std::string& directory)
+	{
+		std::vector<batch_input> result;
+		std::error_code error;
+		for (const auto& entry : std::filesystem::directory_iterator{ directory, error })
+		{
+			if (entry.is_regular_file())
+			{
+				batch_input input;
+				input.path = entry.path();
+				result.push_back(std::move(input));
+			}
+		}
+		// Sorted so that the results file lists inputs in the same order every run.
+		std::ranges::sort(result, {}, &batch_input::path);
+		return result;
+	}
+
+	void solve_batch_input(batch_input& input, const batch_options& options)
+	{
+		const auto start_time = std::chrono::steady_clock::now();
+		try
+		{
+			const utils::mapped_file file{ input.path.string() };
+			if (options.part == 0)
+			{
+				const auto outcomes = advent::solve_both_input(options.day, file.view(), options.solve_timeout);
+				input.outcomes.assign(begin(outcomes), end(outcomes));
+			}
+			else
+			{
+				input.outcomes.push_back(advent::solve_input(options.day, options.part, file.view(), options.solve_timeout));
+			}
+		}
+		catch (const advent::test_failed& failure)
+		{
+			advent::solve_outcome outcome;
+			outcome.error = failure.what();
+			input.outcomes.assign(options.part == 0 ? 2 : 1, outcome);
+		}
+		input.latency = std::chrono::steady_clock::now() - start_time;
+	}
+
+	bool write_batch_results(const std::string& filename, const std::vector<batch_input>& inputs, const batch_options& options)
+	{
+		std::ofstream file{ filename };
+		if (!file.is_open())
+		{
+			return false;
+		}
+		for (const batch_input& input : inputs)
+		{
+			for (std::size_t i = 0; i < input.outcomes.size(); ++i)
+			{
+				const advent::solve_outcome& outcome = input.outcomes[i];
+				const int part = options.part == 0 ? static_cast<int>(i) + 1 : options.part;
+				file << "{\"input\":" << json_escape(input.path.string())
+					<< ",\"day\":" << options.day
+					<< ",\"part\":" << part
+					<< ",\"status\":" << json_escape(to_string(outcome.status));
+				if (outcome.status == advent::solve_status::error)
+				{
+					file << ",\"error\":" << json_escape(outcome.error);
+				}
+				else
+				{
+					if (outcome.status == advent::solve_status::ok)
+					{
+						file << ",\"result\":" << json_escape(outcome.result);
+					}
+					file << ",\"time_ns\":" << outcome.time.count();
+				}
+				file << "}\n";
+			}
+		}
+		return true;
+	}
+}
+
+bool run_batch(const batch_options& options)
+{
+	if (advent::get_solver(options.day, options.part == 0 ? 1 : options.part) == nullptr)
+	{
+		std::cerr << "There is no solver for day " << options.day << " part " << options.part << '\n';
+		return false;
+	}
+
+	std::vector<batch_input> inputs = find_inputs(options.input_directory);
+	if (inputs.empty())
+	{
+		std::cerr << "No inputs found in " << options.input_directory << '\n';
+		return false;
+	}
+
+	// One input per task, so a slow input holds up only its own thread. The pool's threads live
+	// for the whole batch, so nothing is set up again per input.
+	const auto start_time = std::chrono::steady_clock::now();
+	utils::parallel_for(std::size_t{ 0 }, inputs.size(), [&inputs, &options](std::size_t idx)
+		{
+			solve_batch_input(inputs[idx], options);
+		});
+	const std::chrono::nanoseconds total_time = std::chrono::steady_clock::now() - start_time;
+
+	std::vector<std::chrono::nanoseconds> latencies;
+	latencies.reserve(inputs.size());
+	std::ranges::transform(inputs, std::back_inserter(latencies), &batch_input::latency);
+	const auto max_latency = std::ranges::max(latencies);
+	const timing_statistics stats = get_timing_statistics(std::move(latencies));
+
+	std::size_t num_failed = 0;
+	std::size_t num_timed_out = 0;
+	for (const batch_input& input : inputs)
+	{
+		for (const advent::solve_outcome& outcome : input.outcomes)
+		{
+			if (outcome.status == advent::solve_status::error)
+			{
+				if (num_failed < 10)
+				{
+					std::cout << "FAILED: " << input.path.string() << ": " << outcome.error << '\n';
+				}
+				++num_failed;
+			}
+			else if (outcome.status == advent::solve_status::timeout)
+			{
+				++num_timed_out;
+			}
+		}
+	}
+
+	const double seconds = std::chrono::duration<double>(total_time).count();
+	std::cout << "BATCH: day " << options.day << (options.part == 0 ? std::string{ " both parts" } : " part " + std::to_string(options.part))
+		<< ", " << inputs.size() << " inputs on " << utils::get_thread_count() << " threads\n"
+		"    TIME      : " << to_human_readable(total_time) << '\n'
+		<< "    THROUGHPUT: " << std::fixed << std::setprecision(1) << static_cast<double>(inputs.size()) / std::max(seconds, 1e-9) << " inputs/s\n" << std::defaultfloat
+		<< "    LATENCY   : min " << to_human_readable(stats.min)
+		<< " | median " << to_human_readable(stats.median)
+		<< " | mean " << to_human_readable(stats.mean)
+		<< " | p90 " << to_human_readable(stats.p90)
+		<< " | p99 " << to_human_readable(stats.p99)
+		<< " | max " << to_human_readable(max_latency) << '\n'
+		<< "    FAILED    : " << num_failed << '\n'
+		<< "    TIMEOUT   : " << num_timed_out << '\n';
+
+	if (!options.results_file.empty() && !write_batch_results(options.results_file, inputs, options))
+	{
+		std::cerr << "Could not write results to " << options.results_file << '\n';
+	}
+	return num_failed == 0 && num_timed_out == 0;
+}
\ No newline at end of file
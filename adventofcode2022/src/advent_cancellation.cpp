@@ -0,0 +1,39 @@
+#include "../advent/advent_cancellation.h"
+
+#include <limits>
+
+namespace
+{
+	thread_local advent::cancellation_token this_thread_token;
+
+	void restart_countdown() noexcept
+	{
+		using namespace advent::cancellation_internal;
+		checks_until_clock_read = this_thread_token.has_deadline() ? clock_check_interval - 1 : std::numeric_limits<unsigned int>::max();
+	}
+}
+
+advent::cancellation_token advent::get_cancellation_token() noexcept
+{
+	return this_thread_token;
+}
+
+advent::cancellation_scope::cancellation_scope(cancellation_token token) noexcept
+	: m_previous{ this_thread_token }
+{
+	this_thread_token = token;
+	// The first check after a budget is given reads the clock.
+	cancellation_internal::checks_until_clock_read = 0;
+}
+
+advent::cancellation_scope::~cancellation_scope() noexcept
+{
+	this_thread_token = m_previous;
+	restart_countdown();
+}
+
+void advent::cancellation_internal::check_deadline()
+{
+	restart_countdown();
+	this_thread_token.check();
+}
\ No newline at end of file
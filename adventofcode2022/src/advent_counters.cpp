@@ -0,0 +1,177 @@
+#include "../advent/advent_counters.h"
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define ADVENT_PERF_EVENTS 1
+#else
+#define ADVENT_PERF_EVENTS 0
+#endif
+
+namespace
+{
+#if ADVENT_PERF_EVENTS
+	struct event_definition
+	{
+		std::uint32_t type;
+		std::uint64_t config;
+	};
+
+	constexpr std::uint64_t cache_event(std::uint64_t cache, std::uint64_t op, std::uint64_t result)
+	{
+		return cache | (op << 8) | (result << 16);
+	}
+
+	// Same order as the fields of hardware_counters.
+	constexpr std::array<event_definition, 5> events{ {
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+		{ PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS) },
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+	} };
+
+	int open_event(const event_definition& event)
+	{
+		perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = event.type;
+		attr.config = event.config;
+		attr.disabled = 1;
+		// Kernel and hypervisor events are usually off limits to normal users.
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+		// Counts this thread, on whichever CPU it runs.
+		return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+	}
+
+	std::optional<std::uint64_t> read_event(int fd)
+	{
+		if (fd < 0)
+		{
+			return std::nullopt;
+		}
+		struct
+		{
+			std::uint64_t value;
+			std::uint64_t time_enabled;
+			std::uint64_t time_running;
+		} data{};
+		if (read(fd, &data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data.time_running == 0)
+		{
+			return std::nullopt;
+		}
+		// When there are more events than hardware counters the kernel takes turns,
+		// so scale up to estimate the count over the whole time.
+		if (data.time_running < data.time_enabled)
+		{
+			const double scale = static_cast<double>(data.time_enabled) / static_cast<double>(data.time_running);
+			return static_cast<std::uint64_t>(static_cast<double>(data.value) * scale);
+		}
+		return data.value;
+	}
+#endif
+}
+
+advent::counter_set::counter_set()
+{
+	m_fds.fill(-1);
+#if ADVENT_PERF_EVENTS
+	for (std::size_t i = 0; i < num_events; ++i)
+	{
+		m_fds[i] = open_event(events[i]);
+	}
+#endif
+}
+
+advent::counter_set::~counter_set()
+{
+#if ADVENT_PERF_EVENTS
+	for (int fd : m_fds)
+	{
+		if (fd >= 0)
+		{
+			close(fd);
+		}
+	}
+#endif
+}
+
+bool advent::counter_set::any_available() const
+{
+	for (int fd : m_fds)
+	{
+		if (fd >= 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void advent::counter_set::start()
+{
+#if ADVENT_PERF_EVENTS
+	for (int fd : m_fds)
+	{
+		if (fd >= 0)
+		{
+			ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+			ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+#endif
+}
+
+advent::hardware_counters advent::counter_set::stop()
+{
+	hardware_counters result;
+#if ADVENT_PERF_EVENTS
+	for (int fd : m_fds)
+	{
+		if (fd >= 0)
+		{
+			ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+		}
+	}
+	result.cycles = read_event(m_fds[0]);
+	result.instructions = read_event(m_fds[1]);
+	result.l1d_misses = read_event(m_fds[2]);
+	result.llc_misses = read_event(m_fds[3]);
+	result.branch_misses = read_event(m_fds[4]);
+#endif
+	return result;
+}
+
+std::optional<std::string_view> advent::hardware_counters_unavailable_reason()
+{
+#if ADVENT_PERF_EVENTS
+	const int fd = open_event(events[0]);
+	if (fd >= 0)
+	{
+		close(fd);
+		return std::nullopt;
+	}
+	switch (errno)
+	{
+	case EACCES:
+	case EPERM:
+		return "not permitted (check /proc/sys/kernel/perf_event_paranoid)";
+	case ENOENT:
+	case EOPNOTSUPP:
+		return "not supported by this CPU or virtual machine";
+	case ENOSYS:
+		return "not supported by this kernel";
+	default:
+		return "perf_event_open failed";
+	}
+#else
+	return "only supported on Linux";
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "../advent/advent_daemon.h"
+
+#include <string>
+#include <string_view>
+#include <sstream>
+
+#include "../advent/advent_solvers.h"
+#include "../advent/advent_results.h"
+#include "../advent/advent_assert.h"
+
+#include "../utils/mapped_file.h"
+#include "../utils/trim_string.h"
+
+namespace
+{
+	void write_response(std::ostream& results, std::string_view id, int day, int part, const advent::solve_outcome& outcome)
+	{
+		results << "{\"id\":" << json_escape(id)
+			<< ",\"day\":" << day
+			<< ",\"part\":" << part
+			<< ",\"status\":" << json_escape(to_string(outcome.status));
+		if (outcome.status == advent::solve_status::error)
+		{
+			results << ",\"error\":" << json_escape(outcome.error);
+		}
+		else
+		{
+			if (outcome.status == advent::solve_status::ok)
+			{
+				results << ",\"result\":" << json_escape(outcome.result);
+			}
+			results << ",\"time_ns\":" << outcome.time.count();
+		}
+		results << '}' << std::endl;
+	}
+
+	advent::solve_outcome make_error(std::string message)
+	{
+		advent::solve_outcome result;
+		result.error = std::move(message);
+		return result;
+	}
+}
+
+std::size_t run_daemon(std::istream& jobs, std::ostream& results, const daemon_options& options)
+{
+	std::size_t num_failed = 0;
+
+	// Kept between jobs, so inline inputs reuse one buffer once it has grown to fit them.
+	std::string inline_input;
+
+	std::string line;
+	while (std::getline(jobs, line))
+	{
+		if (utils::trim_string(line).empty())
+		{
+			continue;
+		}
+
+		std::istringstream fields{ line };
+		std::string id;
+		int day = 0;
+		int part = 0;
+		std::string source;
+		auto respond = [&](const advent::solve_outcome& outcome)
+		{
+			write_response(results, id, day, part, outcome);
+			if (outcome.status != advent::solve_status::ok)
+			{
+				++num_failed;
+			}
+		};
+
+		if (!(fields >> id >> day >> part >> source))
+		{
+			respond(make_error("Expected <id> <day> <part> file|inline ..., got: " + line));
+			continue;
+		}
+
+		if (source == "file")
+		{
+			std::string path;
+			std::getline(fields, path);
+			if (advent::get_solver(day, part) == nullptr)
+			{
+				// Let solve_input explain, without opening the file first.
+				respond(advent::solve_input(day, part, "", options.job_timeout));
+				continue;
+			}
+			try
+			{
+				// Files are mapped for just this job rather than going through the input cache,
+				// which keeps every input it has seen for the life of the process.
+				const utils::mapped_file file{ std::string{ utils::trim_string(path) } };
+				respond(advent::solve_input(day, part, file.view(), options.job_timeout));
+			}
+			catch (const advent::test_failed& failure)
+			{
+				respond(make_error(std::string{ failure.what() }));
+			}
+		}
+		else if (source == "inline")
+		{
+			std::size_t size = 0;
+			if (!(fields >> size))
+			{
+				respond(make_error("Expected a byte count after inline"));
+				continue;
+			}
+			inline_input.resize(size);
+			jobs.read(inline_input.data(), static_cast<std::streamsize>(size));
+			if (static_cast<std::size_t>(jobs.gcount()) != size)
+			{
+				respond(make_error("Input ended before the job's inline input did"));
+				break;
+			}
+			respond(advent::solve_input(day, part, inline_input, options.job_timeout));
+		}
+		else
+		{
+			respond(make_error("Unknown input source '" + source + "'. Use file or inline."));
+		}
+	}
+	return num_failed;
+}
\ No newline at end of file
@@ -0,0 +1,840 @@
+#include "../advent/advent_generators.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <random>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include "../advent/advent_assert.h"
+
+namespace
+{
+	// mt19937_64 gives the same sequence everywhere, but the standard distributions don't,
+	// so values are drawn from it directly.
+	class input_random
+	{
+		std::mt19937_64 m_engine;
+	public:
+		explicit input_random(std::uint64_t seed) : m_engine{ seed } {}
+
+		// Inclusive at both ends.
+		long long between(long long low, long long high)
+		{
+			AdventCheck(low <= high);
+			const auto range = static_cast<std::uint64_t>(high - low) + 1;
+			return low + static_cast<long long>(m_engine() % range);
+		}
+
+		std::size_t index(std::size_t size)
+		{
+			AdventCheck(size > 0);
+			return static_cast<std::size_t>(m_engine() % size);
+		}
+
+		bool chance(int percent)
+		{
+			return between(0, 99) < percent;
+		}
+
+		template <typename T>
+		const T& pick(const std::vector<T>& values)
+		{
+			return values[index(values.size())];
+		}
+
+		template <typename Container>
+		void shuffle(Container& values)
+		{
+			for (std::size_t i = values.size(); i > 1; --i)
+			{
+				std::swap(values[i - 1], values[index(i)]);
+			}
+		}
+
+		char lowercase() { return static_cast<char>('a' + between(0, 25)); }
+
+		std::string word(int min_length, int max_length)
+		{
+			std::string result(static_cast<std::size_t>(between(min_length, max_length)), ' ');
+			std::generate(begin(result), end(result), [this]() { return lowercase(); });
+			return result;
+		}
+	};
+
+	using generator_func = void(*)(std::ostream&, std::size_t, input_random&);
+
+	void generate_day_1(std::ostream& out, std::size_t num_elves, input_random& rng)
+	{
+		for (std::size_t elf = 0; elf < num_elves; ++elf)
+		{
+			if (elf > 0) out << '\n';
+			const auto num_items = rng.between(1, 15);
+			for (long long item = 0; item < num_items; ++item)
+			{
+				out << rng.between(1000, 60000) << '\n';
+			}
+		}
+	}
+
+	void generate_day_2(std::ostream& out, std::size_t num_rounds, input_random& rng)
+	{
+		for (std::size_t round = 0; round < num_rounds; ++round)
+		{
+			out << static_cast<char>('A' + rng.between(0, 2)) << ' ' << static_cast<char>('X' + rng.between(0, 2)) << '\n';
+		}
+	}
+
+	// Each group of three rucksacks shares exactly one badge, and the halves of each rucksack
+	// share exactly one item.
+	void generate_day_3(std::ostream& out, std::size_t num_rucksacks, input_random& rng)
+	{
+		std::string letters;
+		for (char c = 'a'; c <= 'z'; ++c) letters.push_back(c);
+		for (char c = 'A'; c <= 'Z'; ++c) letters.push_back(c);
+		constexpr std::size_t letters_per_rucksack = 17;
+
+		const std::size_t num_groups = std::max<std::size_t>((num_rucksacks + 2) / 3, 1);
+		for (std::size_t group = 0; group < num_groups; ++group)
+		{
+			rng.shuffle(letters);
+			const char badge = letters[0];
+			for (std::size_t rucksack = 0; rucksack < 3; ++rucksack)
+			{
+				const std::string_view pool = std::string_view{ letters }.substr(1 + rucksack * letters_per_rucksack, letters_per_rucksack);
+				const std::string_view left_pool = pool.substr(1, 8);
+				const std::string_view right_pool = pool.substr(9, 8);
+				const char shared = rng.chance(33) ? badge : pool[0];
+				const auto half_size = static_cast<std::size_t>(rng.between(4, 16));
+
+				std::string left{ shared };
+				if (shared != badge) left.push_back(badge);
+				while (left.size() < half_size) left.push_back(left_pool[rng.index(left_pool.size())]);
+				std::string right{ shared };
+				while (right.size() < half_size) right.push_back(right_pool[rng.index(right_pool.size())]);
+				rng.shuffle(left);
+				rng.shuffle(right);
+				out << left << right << '\n';
+			}
+		}
+	}
+
+	void generate_day_4(std::ostream& out, std::size_t num_pairs, input_random& rng)
+	{
+		auto get_range = [&rng]()
+		{
+			const auto first = rng.between(1, 99);
+			const auto last = rng.between(first, 99);
+			return std::pair{ first, last };
+		};
+		for (std::size_t pair = 0; pair < num_pairs; ++pair)
+		{
+			const auto [a_first, a_last] = get_range();
+			const auto [b_first, b_last] = get_range();
+			out << a_first << '-' << a_last << ',' << b_first << '-' << b_last << '\n';
+		}
+	}
+
+	// Moves are simulated as they are made, and never take a stack's last crate since the answer reads
+	// the top of every stack.
+	void generate_day_5(std::ostream& out, std::size_t num_moves, input_random& rng)
+	{
+		constexpr std::size_t num_stacks = 9;
+		std::array<std::string, num_stacks> stacks;
+		for (std::string& stack : stacks)
+		{
+			const auto height = rng.between(2, 8);
+			for (long long i = 0; i < height; ++i)
+			{
+				stack.push_back(static_cast<char>('A' + rng.between(0, 25)));
+			}
+		}
+
+		auto get_height = [](const std::string& stack) { return stack.size(); };
+		const std::size_t max_height = get_height(std::ranges::max(stacks, {}, get_height));
+		for (std::size_t row = max_height; row > 0; --row)
+		{
+			for (std::size_t s = 0; s < num_stacks; ++s)
+			{
+				if (s > 0) out << ' ';
+				if (stacks[s].size() >= row) out << '[' << stacks[s][row - 1] << ']';
+				else out << "   ";
+			}
+			out << '\n';
+		}
+		for (std::size_t s = 0; s < num_stacks; ++s)
+		{
+			if (s > 0) out << ' ';
+			out << ' ' << s + 1 << ' ';
+		}
+		out << "\n\n";
+
+		std::array<std::size_t, num_stacks> heights;
+		std::ranges::transform(stacks, begin(heights), get_height);
+		for (std::size_t move = 0; move < num_moves; ++move)
+		{
+			std::size_t from = rng.index(num_stacks);
+			while (heights[from] < 2) from = rng.index(num_stacks);
+			std::size_t to = rng.index(num_stacks);
+			while (to == from) to = rng.index(num_stacks);
+			const auto count = static_cast<std::size_t>(rng.between(1, static_cast<long long>(std::min<std::size_t>(heights[from] - 1, 10))));
+			heights[from] -= count;
+			heights[to] += count;
+			out << "move " << count << " from " << from + 1 << " to " << to + 1 << '\n';
+		}
+	}
+
+	// Only three letters are used until the end, so both markers are as late as they can be.
+	void generate_day_6(std::ostream& out, std::size_t length, input_random& rng)
+	{
+		constexpr std::string_view marker = "defghijklmnopq";
+		const std::size_t prefix_length = length > marker.size() ? length - marker.size() : 0;
+		for (std::size_t i = 0; i < prefix_length; ++i)
+		{
+			out << static_cast<char>('a' + rng.between(0, 2));
+		}
+		out << marker;
+	}
+
+	void generate_day_7(std::ostream& out, std::size_t num_files, input_random& rng)
+	{
+		struct directory
+		{
+			std::string name;
+			std::vector<std::size_t> children;
+			std::vector<std::pair<long long, std::string>> files;
+			std::set<std::string> used_names;
+		};
+
+		auto unique_name = [&rng](directory& dir)
+		{
+			std::string name = rng.word(1, 8);
+			while (dir.used_names.contains(name)) name = rng.word(1, 8);
+			dir.used_names.insert(name);
+			return name;
+		};
+
+		std::vector<directory> dirs(std::max<std::size_t>(num_files / 4, 1));
+		for (std::size_t i = 1; i < dirs.size(); ++i)
+		{
+			directory& parent = dirs[rng.index(i)];
+			dirs[i].name = unique_name(parent);
+			parent.children.push_back(i);
+		}
+		num_files = std::max<std::size_t>(num_files, 1);
+		for (std::size_t i = 0; i < num_files; ++i)
+		{
+			directory& dir = dirs[rng.index(dirs.size())];
+			std::string name = unique_name(dir);
+			if (rng.chance(50)) name += '.' + rng.word(1, 3);
+			dir.files.emplace_back(rng.between(1000, 300000), std::move(name));
+		}
+
+		// Part 2 needs the disk fuller than 40000000 but not past its 70000000 capacity, so the sizes
+		// are scaled to a total in between, with the rounding left over going to one file.
+		const long long target_total = rng.between(41000000, 69000000);
+		long long drawn_total = 0;
+		for (const directory& dir : dirs)
+		{
+			for (const auto& file : dir.files) drawn_total += file.first;
+		}
+		long long scaled_total = 0;
+		for (directory& dir : dirs)
+		{
+			for (auto& file : dir.files)
+			{
+				file.first = std::max(1LL, file.first * target_total / drawn_total);
+				scaled_total += file.first;
+			}
+		}
+		const auto has_files = std::ranges::find_if(dirs, [](const directory& dir) { return !dir.files.empty(); });
+		has_files->files.front().first += target_total - scaled_total;
+
+		std::function<void(const directory&)> write_directory = [&](const directory& dir)
+		{
+			out << "$ ls\n";
+			for (std::size_t child : dir.children)
+			{
+				out << "dir " << dirs[child].name << '\n';
+			}
+			for (const auto& [size, name] : dir.files)
+			{
+				out << size << ' ' << name << '\n';
+			}
+			for (std::size_t child : dir.children)
+			{
+				out << "$ cd " << dirs[child].name << '\n';
+				write_directory(dirs[child]);
+				out << "$ cd ..\n";
+			}
+		};
+		out << "$ cd /\n";
+		write_directory(dirs.front());
+	}
+
+	void generate_day_8(std::ostream& out, std::size_t size, input_random& rng)
+	{
+		for (std::size_t y = 0; y < size; ++y)
+		{
+			for (std::size_t x = 0; x < size; ++x)
+			{
+				out << rng.between(0, 9);
+			}
+			out << '\n';
+		}
+	}
+
+	void generate_day_9(std::ostream& out, std::size_t num_moves, input_random& rng)
+	{
+		constexpr std::string_view directions = "UDLR";
+		for (std::size_t move = 0; move < num_moves; ++move)
+		{
+			out << directions[rng.index(directions.size())] << ' ' << rng.between(1, 20) << '\n';
+		}
+	}
+
+	// The screen needs at least 240 cycles, so small scales still give a full program.
+	void generate_day_10(std::ostream& out, std::size_t num_instructions, input_random& rng)
+	{
+		std::size_t cycles = 0;
+		for (std::size_t i = 0; i < num_instructions || cycles < 240; ++i)
+		{
+			if (rng.chance(30))
+			{
+				out << "noop\n";
+				cycles += 1;
+			}
+			else
+			{
+				out << "addx " << rng.between(-20, 20) << '\n';
+				cycles += 2;
+			}
+		}
+	}
+
+	// The number of monkeys is fixed, since part 2 works modulo the product of their tests
+	// and that has to stay small enough to square.
+	void generate_day_11(std::ostream& out, std::size_t num_items, input_random& rng)
+	{
+		constexpr std::size_t num_monkeys = 8;
+		std::vector<int> divisors{ 2,3,5,7,11,13,17,19 };
+		rng.shuffle(divisors);
+		std::array<std::vector<long long>, num_monkeys> items;
+		// Every monkey starts with an item, as in the puzzle; the parser expects at least one.
+		num_items = std::max(num_items, num_monkeys);
+		for (std::size_t i = 0; i < num_items; ++i)
+		{
+			const std::size_t monkey = i < num_monkeys ? i : rng.index(num_monkeys);
+			items[monkey].push_back(rng.between(50, 99));
+		}
+		const std::size_t square_monkey = rng.index(num_monkeys);
+
+		for (std::size_t monkey = 0; monkey < num_monkeys; ++monkey)
+		{
+			if (monkey > 0) out << '\n';
+			out << "Monkey " << monkey << ":\n";
+			out << "  Starting items:";
+			for (std::size_t i = 0; i < items[monkey].size(); ++i)
+			{
+				out << (i == 0 ? " " : ", ") << items[monkey][i];
+			}
+			out << '\n';
+			out << "  Operation: new = ";
+			if (monkey == square_monkey) out << "old * old";
+			else if (rng.chance(50)) out << "old * " << rng.between(2, 19);
+			else out << "old + " << rng.between(1, 8);
+			out << '\n';
+			out << "  Test: divisible by " << divisors[monkey] << '\n';
+			auto other_monkey = [&rng, monkey](std::size_t not_this)
+			{
+				std::size_t result = rng.index(num_monkeys);
+				while (result == monkey || result == not_this) result = rng.index(num_monkeys);
+				return result;
+			};
+			const std::size_t true_target = other_monkey(monkey);
+			out << "    If true: throw to monkey " << true_target << '\n';
+			out << "    If false: throw to monkey " << other_monkey(true_target) << '\n';
+		}
+	}
+
+	// The top row climbs steadily from S to E, so there is always a route; the rest is noise.
+	void generate_day_12(std::ostream& out, std::size_t width, input_random& rng)
+	{
+		width = std::max<std::size_t>(width, 26);
+		const std::size_t height = std::max<std::size_t>(width / 4, 5);
+		for (std::size_t y = 0; y < height; ++y)
+		{
+			for (std::size_t x = 0; x < width; ++x)
+			{
+				const auto base_height = static_cast<long long>(x * 25 / (width - 1));
+				if (y == 0 && x == 0) out << 'S';
+				else if (y == 0 && x == width - 1) out << 'E';
+				else if (y == 0) out << static_cast<char>('a' + base_height);
+				else out << static_cast<char>('a' + std::clamp<long long>(base_height + rng.between(-2, 1), 0, 25));
+			}
+			out << '\n';
+		}
+	}
+
+	std::string random_packet_items(input_random& rng, int depth)
+	{
+		std::string result;
+		const auto num_items = rng.between(0, 4);
+		for (long long i = 0; i < num_items; ++i)
+		{
+			if (i > 0) result += ',';
+			if (depth < 3 && rng.chance(30))
+			{
+				result += '[' + random_packet_items(rng, depth + 1) + ']';
+			}
+			else
+			{
+				result += std::to_string(rng.between(0, 10));
+			}
+		}
+		return result;
+	}
+
+	// Packets in a pair start with different numbers, so every pair has a definite order. Each
+	// packet's second number is unique, so no two packets (or a packet and a divider) compare equal
+	// when part 2 sorts them all.
+	void generate_day_13(std::ostream& out, std::size_t num_pairs, input_random& rng)
+	{
+		std::size_t packet_id = 0;
+		auto write_packet = [&out, &rng, &packet_id](long long first)
+		{
+			const std::string rest = random_packet_items(rng, 1);
+			out << '[' << first << ',' << packet_id++ << (rest.empty() ? "" : ",") << rest << "]\n";
+		};
+		for (std::size_t pair = 0; pair < num_pairs; ++pair)
+		{
+			if (pair > 0) out << '\n';
+			const auto left = rng.between(0, 10);
+			auto right = rng.between(0, 10);
+			while (right == left) right = rng.between(0, 10);
+			write_packet(left);
+			write_packet(right);
+		}
+	}
+
+	// Short, scattered paths, so sand always finds a way past them into the abyss.
+	void generate_day_14(std::ostream& out, std::size_t num_paths, input_random& rng)
+	{
+		const auto spread = static_cast<long long>(10 + num_paths / 2);
+		const auto depth = static_cast<long long>(10 + num_paths);
+		for (std::size_t path = 0; path < num_paths; ++path)
+		{
+			long long x = rng.between(500 - spread, 500 + spread);
+			long long y = rng.between(5, 5 + depth);
+			out << x << ',' << y;
+			bool horizontal = rng.chance(50);
+			const auto num_segments = rng.between(1, 4);
+			for (long long segment = 0; segment < num_segments; ++segment)
+			{
+				auto length = rng.between(1, 6) * (rng.chance(50) ? 1 : -1);
+				if (horizontal) x += length;
+				else
+				{
+					// Turn back rather than shorten a segment, since walls can't have zero length.
+					if (y + length < 1) length = -length;
+					y += length;
+				}
+				horizontal = !horizontal;
+				out << " -> " << x << ',' << y;
+			}
+			out << '\n';
+		}
+	}
+
+	// Sensors in the corners of the search area leave exactly one gap in it. Extra sensors are
+	// scattered around without covering the gap, so part 2 always has a single answer.
+	void generate_day_15(std::ostream& out, std::size_t num_sensors, input_random& rng)
+	{
+		constexpr long long area = 4000000;
+		const long long gap_x = rng.between(area / 4, 3 * area / 4);
+		const long long gap_y = rng.between(area / 4, 3 * area / 4);
+		auto write_sensor = [&out](long long sx, long long sy, long long bx, long long by)
+		{
+			out << "Sensor at x=" << sx << ", y=" << sy << ": closest beacon is at x=" << bx << ", y=" << by << '\n';
+		};
+
+		// A sensor in each corner reaching just short of the gap covers every other point between them,
+		// since any other point is nearer to one of the corners. Every sensor stays inside the search
+		// area so no row's covered range ends up clamped outside it.
+		std::vector<std::array<long long, 4>> sensors{
+			{ 0, 0, gap_x - 1, gap_y },
+			{ area, 0, gap_x + 1, gap_y },
+			{ 0, area, gap_x - 1, gap_y },
+			{ area, area, gap_x + 1, gap_y }
+		};
+		while (sensors.size() < num_sensors + 4)
+		{
+			const long long sx = rng.between(0, area);
+			const long long sy = rng.between(0, area);
+			const long long distance_to_gap = std::abs(sx - gap_x) + std::abs(sy - gap_y);
+			if (distance_to_gap < 2) continue;
+			const long long range = rng.between(1, std::min(distance_to_gap - 1, area / 4));
+			const long long dx = rng.between(-range, range);
+			const long long dy = (range - std::abs(dx)) * (rng.chance(50) ? 1 : -1);
+			sensors.push_back({ sx, sy, sx + dx, sy + dy });
+		}
+		rng.shuffle(sensors);
+		for (const auto& [sx, sy, bx, by] : sensors)
+		{
+			write_sensor(sx, sy, bx, by);
+		}
+	}
+
+	std::string valve_name(std::size_t index)
+	{
+		return { static_cast<char>('A' + index / 26), static_cast<char>('A' + index % 26) };
+	}
+
+	// Scale is the number of valves worth opening. There are three times as many that aren't,
+	// joined up into a connected cave.
+	void generate_day_16(std::ostream& out, std::size_t num_flowing, input_random& rng)
+	{
+		num_flowing = std::clamp<std::size_t>(num_flowing, 1, 60);
+		const std::size_t num_valves = std::min<std::size_t>(num_flowing * 4, 26 * 26);
+		std::vector<std::set<std::size_t>> tunnels(num_valves);
+		auto connect = [&tunnels](std::size_t a, std::size_t b)
+		{
+			if (a == b) return;
+			tunnels[a].insert(b);
+			tunnels[b].insert(a);
+		};
+		for (std::size_t valve = 1; valve < num_valves; ++valve)
+		{
+			connect(valve, rng.index(valve));
+		}
+		for (std::size_t extra = 0; extra < num_valves / 2; ++extra)
+		{
+			connect(rng.index(num_valves), rng.index(num_valves));
+		}
+
+		// Valve AA is the start, and never has any flow.
+		std::vector<std::size_t> order(num_valves);
+		for (std::size_t i = 0; i < num_valves; ++i) order[i] = i;
+		rng.shuffle(order);
+		std::vector<int> flows(num_valves, 0);
+		std::size_t flowing = 0;
+		for (std::size_t valve : order)
+		{
+			if (flowing == num_flowing) break;
+			if (valve == 0) continue;
+			flows[valve] = static_cast<int>(rng.between(2, 25));
+			++flowing;
+		}
+
+		for (std::size_t valve : order)
+		{
+			const auto& exits = tunnels[valve];
+			out << "Valve " << valve_name(valve) << " has flow rate=" << flows[valve] << "; "
+				<< (exits.size() == 1 ? "tunnel leads to valve " : "tunnels lead to valves ");
+			bool first = true;
+			for (std::size_t exit : exits)
+			{
+				out << (first ? "" : ", ") << valve_name(exit);
+				first = false;
+			}
+			out << '\n';
+		}
+	}
+
+	void generate_day_17(std::ostream& out, std::size_t length, input_random& rng)
+	{
+		for (std::size_t i = 0; i < std::max<std::size_t>(length, 1); ++i)
+		{
+			out << (rng.chance(50) ? '<' : '>');
+		}
+	}
+
+	void generate_day_18(std::ostream& out, std::size_t num_cubes, input_random& rng)
+	{
+		long long side = 1;
+		while (side * side * side < static_cast<long long>(num_cubes) * 3) ++side;
+		std::set<std::array<long long, 3>> cubes;
+		while (cubes.size() < num_cubes)
+		{
+			const std::array<long long, 3> cube{ rng.between(0, side), rng.between(0, side), rng.between(0, side) };
+			if (cubes.insert(cube).second)
+			{
+				out << cube[0] << ',' << cube[1] << ',' << cube[2] << '\n';
+			}
+		}
+	}
+
+	void generate_day_19(std::ostream& out, std::size_t num_blueprints, input_random& rng)
+	{
+		for (std::size_t id = 1; id <= std::max<std::size_t>(num_blueprints, 3); ++id)
+		{
+			out << "Blueprint " << id << ": "
+				<< "Each ore robot costs " << rng.between(2, 4) << " ore. "
+				<< "Each clay robot costs " << rng.between(2, 4) << " ore. "
+				<< "Each obsidian robot costs " << rng.between(2, 4) << " ore and " << rng.between(5, 20) << " clay. "
+				<< "Each geode robot costs " << rng.between(2, 4) << " ore and " << rng.between(5, 20) << " obsidian.\n";
+		}
+	}
+
+	// Exactly one zero, as the puzzle needs.
+	void generate_day_20(std::ostream& out, std::size_t num_values, input_random& rng)
+	{
+		num_values = std::max<std::size_t>(num_values, 2);
+		const std::size_t zero_index = rng.index(num_values);
+		for (std::size_t i = 0; i < num_values; ++i)
+		{
+			long long value = 0;
+			while (i != zero_index && value == 0) value = rng.between(-10000, 10000);
+			out << value << '\n';
+		}
+	}
+
+	// The tree is built down from the values each monkey should yell, so divisions are exact and
+	// everything stays positive. Only + and - lie between root and humn, so part 2 has a whole-number answer.
+	void generate_day_21(std::ostream& out, std::size_t num_monkeys, input_random& rng)
+	{
+		num_monkeys = std::clamp<std::size_t>(num_monkeys | 1, 3, 26 * 26 * 26 * 26 / 2);
+		std::size_t next_name = 0;
+		auto get_name = [&next_name]()
+		{
+			std::string name;
+			do
+			{
+				std::size_t n = next_name++;
+				name.assign(4, 'a');
+				for (std::size_t i = 4; i > 0; --i)
+				{
+					name[i - 1] = static_cast<char>('a' + n % 26);
+					n /= 26;
+				}
+			} while (name == "root" || name == "humn");
+			return name;
+		};
+
+		std::vector<std::string> lines;
+		std::function<std::string(std::size_t, long long, bool)> build = [&](std::size_t leaves, long long target, bool has_human)
+		{
+			if (leaves == 1)
+			{
+				if (has_human)
+				{
+					// Part 1 uses some other value; target is what part 2 should find.
+					lines.push_back("humn: " + std::to_string(rng.between(1, 5000)));
+					return std::string{ "humn" };
+				}
+				std::string name = get_name();
+				lines.push_back(name + ": " + std::to_string(target));
+				return name;
+			}
+
+			const std::size_t left_leaves = static_cast<std::size_t>(rng.between(1, static_cast<long long>(leaves) - 1));
+			const bool human_on_left = has_human && rng.index(leaves) < left_leaves;
+			char op = '-';
+			long long left = 0;
+			long long right = 0;
+			const int choice = static_cast<int>(rng.between(0, 3));
+			long long divisor = rng.between(2, 9);
+			if (choice == 0 && target >= 2)
+			{
+				op = '+';
+				left = rng.between(1, target - 1);
+				right = target - left;
+			}
+			else if (choice == 1 && !has_human && target >= 4 && target % divisor == 0)
+			{
+				op = '*';
+				left = target / divisor;
+				right = divisor;
+			}
+			else if (choice == 2 && !has_human && target >= 1 && target <= 1'000'000'000)
+			{
+				op = '/';
+				divisor = rng.between(2, 5);
+				left = target * divisor;
+				right = divisor;
+			}
+			else
+			{
+				right = rng.between(1, 1000) + std::max(0ll, 1 - target);
+				left = target + right;
+			}
+			if (rng.chance(50) && (op == '+' || op == '*'))
+			{
+				std::swap(left, right);
+			}
+
+			const std::string name = get_name();
+			const std::string left_name = build(left_leaves, left, human_on_left);
+			const std::string right_name = build(leaves - left_leaves, right, has_human && !human_on_left);
+			lines.push_back(name + ": " + left_name + ' ' + op + ' ' + right_name);
+			return name;
+		};
+
+		const std::size_t leaves = (num_monkeys + 1) / 2;
+		const std::size_t left_leaves = static_cast<std::size_t>(rng.between(1, static_cast<long long>(leaves) - 1));
+		const long long target = rng.between(1000, 1'000'000);
+		const bool human_on_left = rng.chance(50);
+		const std::string left_name = build(left_leaves, target, human_on_left);
+		const std::string right_name = build(leaves - left_leaves, target, !human_on_left);
+		lines.push_back("root: " + left_name + " + " + right_name);
+
+		rng.shuffle(lines);
+		for (const std::string& line : lines)
+		{
+			out << line << '\n';
+		}
+	}
+
+	// The map is the same cube net as the puzzle input, with faces of the given size.
+	void generate_day_22(std::ostream& out, std::size_t face_size, input_random& rng)
+	{
+		face_size = std::max<std::size_t>(face_size, 2);
+		constexpr std::array<std::string_view, 4> layout{ " ##", " #", "##", "#" };
+		for (std::size_t face_row = 0; face_row < layout.size(); ++face_row)
+		{
+			for (std::size_t y = 0; y < face_size; ++y)
+			{
+				bool first_tile = true;
+				for (char face : layout[face_row])
+				{
+					for (std::size_t x = 0; x < face_size; ++x)
+					{
+						if (face == ' ')
+						{
+							out << ' ';
+							continue;
+						}
+						// The walk starts at the first tile, so that one is always open.
+						const bool is_start = face_row == 0 && y == 0 && first_tile;
+						out << (!is_start && rng.chance(10) ? '#' : '.');
+						first_tile = false;
+					}
+				}
+				out << '\n';
+			}
+		}
+		out << '\n';
+		const std::size_t num_moves = face_size * 4;
+		for (std::size_t move = 0; move < num_moves; ++move)
+		{
+			out << rng.between(1, static_cast<long long>(face_size));
+			if (move + 1 < num_moves)
+			{
+				out << (rng.chance(50) ? 'L' : 'R');
+			}
+		}
+	}
+
+	void generate_day_23(std::ostream& out, std::size_t size, input_random& rng)
+	{
+		for (std::size_t y = 0; y < size; ++y)
+		{
+			for (std::size_t x = 0; x < size; ++x)
+			{
+				out << (rng.chance(45) ? '#' : '.');
+			}
+			out << '\n';
+		}
+	}
+
+	// As in the puzzle, no blizzard moves up or down the entrance or exit columns.
+	void generate_day_24(std::ostream& out, std::size_t width, input_random& rng)
+	{
+		width = std::max<std::size_t>(width, 3);
+		const std::size_t height = std::max<std::size_t>(width / 5, 3);
+		out << "#." << std::string(width - 1, '#') << "#\n";
+		for (std::size_t y = 0; y < height; ++y)
+		{
+			out << '#';
+			for (std::size_t x = 0; x < width; ++x)
+			{
+				const bool can_go_vertical = x != 0 && x != width - 1;
+				const auto blizzard = rng.between(0, 99);
+				if (blizzard < 10) out << '<';
+				else if (blizzard < 20) out << '>';
+				else if (blizzard < 25 && can_go_vertical) out << '^';
+				else if (blizzard < 30 && can_go_vertical) out << 'v';
+				else out << '.';
+			}
+			out << "#\n";
+		}
+		out << '#' << std::string(width - 1, '#') << ".#\n";
+	}
+
+	void generate_day_25(std::ostream& out, std::size_t num_values, input_random& rng)
+	{
+		constexpr std::string_view digits = "=-012";
+		for (std::size_t i = 0; i < num_values; ++i)
+		{
+			out << (rng.chance(50) ? '1' : '2');
+			const auto length = rng.between(0, 19);
+			for (long long d = 0; d < length; ++d)
+			{
+				out << digits[rng.index(digits.size())];
+			}
+			out << '\n';
+		}
+	}
+
+	struct generator
+	{
+		generator_func func;
+		std::string_view scale_description;
+	};
+
+	constexpr std::array<generator, advent::last_generated_day> generators{ {
+		{ generate_day_1, "elves" },
+		{ generate_day_2, "rounds" },
+		{ generate_day_3, "rucksacks" },
+		{ generate_day_4, "pairs of elves" },
+		{ generate_day_5, "moves" },
+		{ generate_day_6, "characters" },
+		{ generate_day_7, "files" },
+		{ generate_day_8, "width and height of the forest" },
+		{ generate_day_9, "moves" },
+		{ generate_day_10, "instructions" },
+		{ generate_day_11, "items" },
+		{ generate_day_12, "width of the heightmap" },
+		{ generate_day_13, "pairs of packets" },
+		{ generate_day_14, "rock paths" },
+		{ generate_day_15, "sensors" },
+		{ generate_day_16, "valves with flow (at most 60)" },
+		{ generate_day_17, "jets" },
+		{ generate_day_18, "cubes" },
+		{ generate_day_19, "blueprints" },
+		{ generate_day_20, "numbers" },
+		{ generate_day_21, "monkeys" },
+		{ generate_day_22, "size of a cube face" },
+		{ generate_day_23, "width and height of the grove" },
+		{ generate_day_24, "width of the valley" },
+		{ generate_day_25, "numbers" }
+	} };
+
+	const generator& get_generator(int day)
+	{
+		AdventCheckMsg(day >= advent::first_generated_day && day <= advent::last_generated_day, "There is no input generator for day", day);
+		return generators[static_cast<std::size_t>(day - advent::first_generated_day)];
+	}
+}
+
+std::string advent::generate_input(int day, std::size_t scale, std::uint64_t seed)
+{
+	const generator& gen = get_generator(day);
+	// Mixing in the day means one seed gives unrelated inputs for different days.
+	input_random rng{ seed * 100 + static_cast<std::uint64_t>(day) };
+	std::ostringstream out;
+	gen.func(out, scale, rng);
+	std::string result = std::move(out).str();
+	while (!result.empty() && result.back() == '\n')
+	{
+		result.pop_back();
+	}
+	return result;
+}
+
+std::string_view advent::describe_input_scale(int day)
+{
+	return get_generator(day).scale_description;
+}
\ No newline at end of file
@@ -0,0 +1,229 @@
+#include "../advent/advent_host.h"
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "../utils/trim_string.h"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#include <powrprof.h>
+#pragma comment(lib, "PowrProf.lib")
+#define ADVENT_HOST_WIN32 1
+#elif defined(__linux__)
+#include <cerrno>
+#include <sched.h>
+#include <cstdlib>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define ADVENT_HOST_LINUX 1
+#endif
+
+namespace
+{
+#if ADVENT_HOST_LINUX
+	std::string read_first_line(const std::string& filename)
+	{
+		std::ifstream file{ filename };
+		std::string line;
+		std::getline(file, line);
+		return std::string{ utils::trim_string(line) };
+	}
+
+	// The value of the first "key : value" line in /proc/cpuinfo with one of these keys.
+	// x86 calls it "model name"; some ARM kernels only have "Processor" or "Hardware".
+	std::string read_cpu_model()
+	{
+		std::ifstream file{ "/proc/cpuinfo" };
+		std::string line;
+		for (const std::string_view key : { "model name", "Processor", "Hardware" })
+		{
+			file.clear();
+			file.seekg(0);
+			while (std::getline(file, line))
+			{
+				const std::size_t colon = line.find(':');
+				if (colon == std::string::npos) continue;
+				if (utils::trim_string(std::string_view{ line }.substr(0, colon)) == key)
+				{
+					return std::string{ utils::trim_string(std::string_view{ line }.substr(colon + 1)) };
+				}
+			}
+		}
+		return "";
+	}
+
+	std::optional<bool> read_turbo_enabled()
+	{
+		// intel_pstate reports the opposite of the generic cpufreq setting.
+		const std::string no_turbo = read_first_line("/sys/devices/system/cpu/intel_pstate/no_turbo");
+		if (!no_turbo.empty())
+		{
+			return no_turbo == "0";
+		}
+		const std::string boost = read_first_line("/sys/devices/system/cpu/cpufreq/boost");
+		if (!boost.empty())
+		{
+			return boost == "1";
+		}
+		return std::nullopt;
+	}
+
+	pid_t current_thread_id()
+	{
+		return static_cast<pid_t>(syscall(SYS_gettid));
+	}
+#endif
+
+#if ADVENT_HOST_WIN32
+	std::string read_cpu_model()
+	{
+		char name[256] = {};
+		DWORD size = sizeof(name);
+		if (RegGetValueA(HKEY_LOCAL_MACHINE, "HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\0",
+			"ProcessorNameString", RRF_RT_REG_SZ, nullptr, name, &size) != ERROR_SUCCESS)
+		{
+			return "";
+		}
+		return std::string{ utils::trim_string(name) };
+	}
+
+	std::string read_power_plan()
+	{
+		GUID* scheme = nullptr;
+		if (PowerGetActiveScheme(nullptr, &scheme) != ERROR_SUCCESS)
+		{
+			return "";
+		}
+		std::string result;
+		DWORD size = 0;
+		if (PowerReadFriendlyName(nullptr, scheme, nullptr, nullptr, nullptr, &size) == ERROR_SUCCESS && size > 0)
+		{
+			std::wstring wide_name(size / sizeof(wchar_t), L'\0');
+			if (PowerReadFriendlyName(nullptr, scheme, nullptr, nullptr, reinterpret_cast<UCHAR*>(wide_name.data()), &size) == ERROR_SUCCESS)
+			{
+				const int length = WideCharToMultiByte(CP_UTF8, 0, wide_name.c_str(), -1, nullptr, 0, nullptr, nullptr);
+				if (length > 1)
+				{
+					result.resize(static_cast<std::size_t>(length - 1));
+					WideCharToMultiByte(CP_UTF8, 0, wide_name.c_str(), -1, result.data(), length, nullptr, nullptr);
+				}
+			}
+		}
+		LocalFree(scheme);
+		return result;
+	}
+#endif
+}
+
+advent::host_info advent::get_host_info(int core)
+{
+	host_info result;
+	result.logical_cores = std::thread::hardware_concurrency();
+#if ADVENT_HOST_LINUX
+	result.cpu_model = read_cpu_model();
+	std::ostringstream governor_file;
+	governor_file << "/sys/devices/system/cpu/cpu" << core << "/cpufreq/scaling_governor";
+	result.governor = read_first_line(governor_file.str());
+	result.turbo_enabled = read_turbo_enabled();
+	double load = 0.0;
+	if (getloadavg(&load, 1) == 1)
+	{
+		result.load_average = load;
+	}
+#elif ADVENT_HOST_WIN32
+	static_cast<void>(core);
+	result.cpu_model = read_cpu_model();
+	result.governor = read_power_plan();
+#else
+	static_cast<void>(core);
+#endif
+	return result;
+}
+
+advent::thread_isolation::thread_isolation(int core, bool raise_priority)
+	: m_core{ core }
+{
+#if ADVENT_HOST_LINUX
+	if (core >= 0 && core < CPU_SETSIZE)
+	{
+		cpu_set_t previous;
+		CPU_ZERO(&previous);
+		if (sched_getaffinity(0, sizeof(previous), &previous) == 0)
+		{
+			for (int i = 0; i < CPU_SETSIZE; ++i)
+			{
+				if (CPU_ISSET(i, &previous))
+				{
+					m_previous_cores.push_back(i);
+				}
+			}
+			cpu_set_t target;
+			CPU_ZERO(&target);
+			CPU_SET(core, &target);
+			m_pinned = sched_setaffinity(0, sizeof(target), &target) == 0;
+		}
+	}
+	if (raise_priority)
+	{
+		// On Linux each thread has its own nice value, set through its thread id.
+		errno = 0;
+		m_previous_nice = getpriority(PRIO_PROCESS, static_cast<id_t>(current_thread_id()));
+		m_raised_priority = errno == 0 && setpriority(PRIO_PROCESS, static_cast<id_t>(current_thread_id()), -20) == 0;
+	}
+#elif ADVENT_HOST_WIN32
+	if (core >= 0 && core < 64)
+	{
+		const DWORD_PTR previous = SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{ 1 } << core);
+		m_previous_affinity = previous;
+		m_pinned = previous != 0;
+	}
+	if (raise_priority)
+	{
+		m_previous_priority_class = GetPriorityClass(GetCurrentProcess());
+		m_previous_priority = GetThreadPriority(GetCurrentThread());
+		m_raised_priority_class = SetPriorityClass(GetCurrentProcess(), HIGH_PRIORITY_CLASS) != 0;
+		m_raised_thread_priority = SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST) != 0;
+		m_raised_priority = m_raised_priority_class && m_raised_thread_priority;
+	}
+#else
+	static_cast<void>(raise_priority);
+#endif
+}
+
+advent::thread_isolation::~thread_isolation()
+{
+#if ADVENT_HOST_LINUX
+	if (m_pinned)
+	{
+		cpu_set_t previous;
+		CPU_ZERO(&previous);
+		for (int i : m_previous_cores)
+		{
+			CPU_SET(i, &previous);
+		}
+		sched_setaffinity(0, sizeof(previous), &previous);
+	}
+	if (m_raised_priority)
+	{
+		setpriority(PRIO_PROCESS, static_cast<id_t>(current_thread_id()), m_previous_nice);
+	}
+#elif ADVENT_HOST_WIN32
+	if (m_pinned)
+	{
+		SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(m_previous_affinity));
+	}
+	if (m_raised_thread_priority)
+	{
+		SetThreadPriority(GetCurrentThread(), m_previous_priority);
+	}
+	if (m_raised_priority_class)
+	{
+		SetPriorityClass(GetCurrentProcess(), m_previous_priority_class);
+	}
+#endif
+}
\ No newline at end of file
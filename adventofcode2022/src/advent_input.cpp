@@ -0,0 +1,238 @@
+#include "../advent/advent_input.h"
+
+#include <sstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <iterator>
+#include <algorithm>
+
+#include "../advent/advent_assert.h"
+
+#include "../utils/mapped_file.h"
+
+namespace
+{
+	// Inputs are used as mapped unless they have Windows line endings, in which case a normalised
+	// copy is kept instead.
+	struct cached_input
+	{
+		utils::mapped_file file;
+		std::string normalised;
+		std::string_view text;
+
+		explicit cached_input(const std::string& filename) : file{ filename }, text{ file.view() }
+		{
+			if (text.find('\r') != std::string_view::npos)
+			{
+				normalised = advent::normalise_line_endings(text);
+				file = utils::mapped_file{};
+				text = normalised;
+			}
+		}
+		cached_input(const cached_input&) = delete;
+		cached_input& operator=(const cached_input&) = delete;
+	};
+
+	class input_cache
+	{
+		std::mutex m_lock;
+		// Map nodes never move, and cached inputs own their memory, so views survive the map growing.
+		std::map<std::string, cached_input, std::less<>> m_inputs;
+	public:
+		std::string_view get(const std::string& filename)
+		{
+			std::lock_guard guard{ m_lock };
+			const auto find_result = m_inputs.find(filename);
+			if (find_result != end(m_inputs))
+			{
+				return find_result->second.text;
+			}
+			const auto insert_result = m_inputs.try_emplace(filename, filename);
+			return insert_result.first->second.text;
+		}
+	};
+
+	input_cache& get_input_cache()
+	{
+		static input_cache cache;
+		return cache;
+	}
+
+	thread_local const advent::puzzle_input_override* current_override = nullptr;
+
+	const advent::puzzle_input_override* find_override(int day)
+	{
+		for (const advent::puzzle_input_override* over = current_override; over != nullptr; over = over->get_previous())
+		{
+			if (over->get_day() == day)
+			{
+				return over;
+			}
+		}
+		return nullptr;
+	}
+
+	bool is_newline(char c)
+	{
+		return c == '\n' || c == '\r';
+	}
+
+	// What advent::normalise_line_endings does, but in place.
+	void normalise_line_endings_in_place(std::vector<char>& text)
+	{
+		auto out = begin(text);
+		for (auto it = begin(text); it != end(text); ++it)
+		{
+			if (*it == '\r' && std::next(it) != end(text) && *std::next(it) == '\n')
+			{
+				continue;
+			}
+			*out++ = *it;
+		}
+		text.erase(out, end(text));
+	}
+}
+
+advent::trimmed_streambuf::int_type advent::trimmed_streambuf::underflow()
+{
+	constexpr std::size_t chunk_size = 4096;
+	if (gptr() < egptr())
+	{
+		return traits_type::to_int_type(*gptr());
+	}
+
+	// Newlines held back from last time go first, as something else followed them.
+	m_buffer.assign(begin(m_held_newlines), end(m_held_newlines));
+	m_held_newlines.clear();
+	while (true)
+	{
+		const std::size_t old_size = m_buffer.size();
+		m_buffer.resize(old_size + chunk_size);
+		const auto num_read = static_cast<std::size_t>(m_source->sgetn(m_buffer.data() + old_size, static_cast<std::streamsize>(chunk_size)));
+		m_buffer.resize(old_size + num_read);
+		if (num_read == 0)
+		{
+			// The source has ended, so anything held back was trailing.
+			return traits_type::eof();
+		}
+
+		const auto last_kept = std::find_if_not(m_buffer.rbegin(), m_buffer.rend(), is_newline).base();
+		m_held_newlines.assign(last_kept, end(m_buffer));
+		m_buffer.erase(last_kept, end(m_buffer));
+		if (!m_buffer.empty())
+		{
+			break;
+		}
+
+		// Nothing but newlines so far, so whether they are trailing depends on what comes next.
+		m_buffer.assign(begin(m_held_newlines), end(m_held_newlines));
+		m_held_newlines.clear();
+	}
+
+	// The buffer doesn't end in a newline, so a "\r\n" split between reads has been put back together
+	// from the held newlines by now.
+	normalise_line_endings_in_place(m_buffer);
+	setg(m_buffer.data(), m_buffer.data(), m_buffer.data() + m_buffer.size());
+	return traits_type::to_int_type(*gptr());
+}
+
+advent::puzzle_input_override::puzzle_input_override(int day, std::string_view text) noexcept
+	: m_previous{ current_override }
+	, m_day{ day }
+	, m_text{ text }
+{
+	current_override = this;
+}
+
+advent::puzzle_input_override::puzzle_input_override(int day, std::istream& source) noexcept
+	: m_previous{ current_override }
+	, m_day{ day }
+	, m_stream_state{ stream_state::unread }
+{
+	m_stream.emplace(*source.rdbuf());
+	current_override = this;
+}
+
+advent::puzzle_input_override::~puzzle_input_override() noexcept
+{
+	current_override = m_previous;
+}
+
+std::string_view advent::puzzle_input_override::get_text() const
+{
+	AdventCheckMsg(m_stream_state != stream_state::streamed, "Day", m_day, "input has already been streamed, so it can't be read again");
+	if (m_stream_state == stream_state::none)
+	{
+		if (m_text.find('\r') == std::string_view::npos)
+		{
+			return m_text;
+		}
+		m_buffered_text = normalise_line_endings(m_text);
+		m_stream_state = stream_state::buffered;
+	}
+	if (m_stream_state == stream_state::unread)
+	{
+		m_buffered_text.assign(std::istreambuf_iterator<char>{ &*m_stream }, std::istreambuf_iterator<char>{});
+		if (m_buffered_text.find('\r') != std::string::npos)
+		{
+			m_buffered_text = normalise_line_endings(m_buffered_text);
+		}
+		m_stream_state = stream_state::buffered;
+	}
+	return m_buffered_text;
+}
+
+std::streambuf* advent::puzzle_input_override::get_stream() const
+{
+	AdventCheckMsg(m_stream_state != stream_state::streamed, "Day", m_day, "input has already been streamed, so it can't be read again");
+	if (m_stream_state != stream_state::unread)
+	{
+		return nullptr;
+	}
+	m_stream_state = stream_state::streamed;
+	return &*m_stream;
+}
+
+std::streambuf* advent::get_puzzle_stream(int day)
+{
+	const puzzle_input_override* over = find_override(day);
+	return over != nullptr ? over->get_stream() : nullptr;
+}
+
+std::string advent::normalise_line_endings(std::string_view text)
+{
+	std::string result;
+	result.reserve(text.size());
+	while (!text.empty())
+	{
+		const std::size_t line_end = text.find("\r\n");
+		if (line_end == std::string_view::npos)
+		{
+			result.append(text);
+			break;
+		}
+		result.append(text.substr(0, line_end));
+		result.push_back('\n');
+		text.remove_prefix(line_end + 2);
+	}
+	return result;
+}
+
+std::string_view advent::get_puzzle_input(int day)
+{
+	if (const puzzle_input_override* over = find_override(day))
+	{
+		return over->get_text();
+	}
+	std::ostringstream name;
+	name << "advent" << day << "/advent" << day << ".txt";
+	return get_input_cache().get(name.str());
+}
+
+std::string_view advent::get_testcase_input(int day, char id)
+{
+	std::ostringstream name;
+	name << "advent" << day << "/testcase_" << id << ".txt";
+	return get_input_cache().get(name.str());
+}
\ No newline at end of file
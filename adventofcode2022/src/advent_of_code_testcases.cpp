@@ -9,10 +9,25 @@
 #include <iomanip>
 #include <cassert>
 #include <numeric>
+#include <map>
+#include <atomic>
+#include <vector>
+#include <mutex>
+#include <fstream>
+#include <cmath>
 
 #include "../advent/advent_of_code.h"
 #include "../advent/advent_headers.h"
 #include "../advent/advent_setup.h"
+#include "../advent/advent_results.h"
+#include "../advent/advent_trace.h"
+#include "../advent/advent_cancellation.h"
+
+#include "../utils/istream_line_iterator.h"
+#include "../utils/split_string.h"
+#include "../utils/to_value.h"
+#include "../utils/thread_pool.h"
+#include "../utils/arena_resource.h"
 
 std::string to_string(const ResultType& rt)
 {
@@ -22,25 +37,6 @@ std::string to_string(const ResultType& rt)
 	return "!ERROR!";
 }
 
-// Result a test can give.
-enum class test_status : char
-{
-	pass,
-	fail,
-	unknown,
-	filtered
-};
-
-// Full results of a test.
-struct test_result
-{
-	std::string name;
-	std::string result;
-	std::string expected;
-	test_status status = test_status::unknown;
-	std::chrono::nanoseconds time_taken;
-};
-
 template <test_status status>
 bool check_result(const test_result& result)
 {
@@ -140,9 +136,157 @@ std::string to_human_readable(std::chrono::nanoseconds time)
 	return to_human_readable(us);
 }
 
-test_result run_test(const verification_test& test, std::string_view filter)
+timing_statistics get_timing_statistics(std::vector<std::chrono::nanoseconds> samples)
 {
-	if (test.name.find(filter) == test.name.npos)
+	AdventCheck(!samples.empty());
+	std::sort(begin(samples), end(samples));
+	const std::size_t num_samples = samples.size();
+
+	// Nearest-rank percentile.
+	auto percentile = [&samples, num_samples](double fraction)
+	{
+		const auto rank = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(num_samples)));
+		return samples[std::clamp<std::size_t>(rank, 1, num_samples) - 1];
+	};
+
+	const std::size_t mid = num_samples / 2;
+	const auto median = (num_samples % 2 == 1) ? samples[mid] : (samples[mid - 1] + samples[mid]) / 2;
+
+	const double mean = std::transform_reduce(begin(samples), end(samples), 0.0, std::plus<double>{},
+		[](std::chrono::nanoseconds sample) {return static_cast<double>(sample.count()); }) / static_cast<double>(num_samples);
+
+	const double sum_of_squares = std::transform_reduce(begin(samples), end(samples), 0.0, std::plus<double>{},
+		[mean](std::chrono::nanoseconds sample)
+		{
+			const double diff = static_cast<double>(sample.count()) - mean;
+			return diff * diff;
+		});
+	const double std_dev = num_samples > 1 ? std::sqrt(sum_of_squares / static_cast<double>(num_samples - 1)) : 0.0;
+
+	timing_statistics result;
+	result.num_samples = num_samples;
+	result.min = samples.front();
+	result.median = median;
+	result.mean = std::chrono::nanoseconds{ static_cast<long long>(mean) };
+	result.p90 = percentile(0.9);
+	result.p99 = percentile(0.99);
+	result.std_dev = std::chrono::nanoseconds{ static_cast<long long>(std_dev) };
+	result.coefficient_of_variation = mean > 0.0 ? std_dev / mean : 0.0;
+	return result;
+}
+
+std::string timing_statistics_to_string(const timing_statistics& stats)
+{
+	std::ostringstream oss;
+	oss << "min " << to_human_readable(stats.min)
+		<< " | median " << to_human_readable(stats.median)
+		<< " | mean " << to_human_readable(stats.mean)
+		<< " | p90 " << to_human_readable(stats.p90)
+		<< " | p99 " << to_human_readable(stats.p99)
+		<< " | cv " << std::fixed << std::setprecision(2) << stats.coefficient_of_variation * 100.0 << '%'
+		<< " (" << stats.num_samples << " runs)";
+	return oss.str();
+}
+
+std::string bytes_to_human_readable(std::size_t bytes)
+{
+	if (bytes < 10'000)
+	{
+		return std::to_string(bytes) + "B";
+	}
+	std::ostringstream oss;
+	oss << std::fixed << std::setprecision(1);
+	if (bytes < 10'000'000)
+	{
+		oss << static_cast<double>(bytes) / 1024.0 << "KiB";
+	}
+	else
+	{
+		oss << static_cast<double>(bytes) / (1024.0 * 1024.0) << "MiB";
+	}
+	return oss.str();
+}
+
+std::string allocation_stats_to_string(const advent::allocation_stats& stats)
+{
+	std::ostringstream oss;
+	oss << "heap: " << stats.allocations << " allocations (" << bytes_to_human_readable(stats.bytes_allocated) << ')'
+		<< " | " << stats.deallocations << " frees"
+		<< " | peak " << bytes_to_human_readable(stats.peak_live_bytes);
+	return oss.str();
+}
+
+std::string count_to_human_readable(std::uint64_t count)
+{
+	if (count < 10'000)
+	{
+		return std::to_string(count);
+	}
+	std::ostringstream oss;
+	oss << std::fixed << std::setprecision(1);
+	if (count < 10'000'000)
+	{
+		oss << static_cast<double>(count) / 1e3 << 'k';
+	}
+	else if (count < 10'000'000'000)
+	{
+		oss << static_cast<double>(count) / 1e6 << 'M';
+	}
+	else
+	{
+		oss << static_cast<double>(count) / 1e9 << 'G';
+	}
+	return oss.str();
+}
+
+std::string hardware_counters_to_string(const advent::hardware_counters& counters)
+{
+	std::ostringstream oss;
+	oss << "counters (test thread):";
+	const char* separator = " ";
+	auto add_count = [&oss, &separator](const std::optional<std::uint64_t>& count, const char* name)
+	{
+		if (count.has_value())
+		{
+			oss << separator << count_to_human_readable(count.value()) << ' ' << name;
+			separator = " | ";
+		}
+	};
+	add_count(counters.cycles, "cycles");
+	add_count(counters.instructions, "instructions");
+	if (const auto ipc = counters.ipc())
+	{
+		oss << separator << "IPC " << std::fixed << std::setprecision(2) << ipc.value();
+	}
+	add_count(counters.l1d_misses, "L1d misses");
+	add_count(counters.llc_misses, "LLC misses");
+	add_count(counters.branch_misses, "branch misses");
+	return oss.str();
+}
+
+// Shows each phase as a share of the mean run time. Anything not inside a phase is "other".
+std::string phases_to_string(const std::vector<advent::phase_timing>& phases, std::chrono::nanoseconds total_time)
+{
+	auto get_percent = [total_time](std::chrono::nanoseconds time)
+	{
+		return 100.0 * static_cast<double>(time.count()) / static_cast<double>(std::max<long long>(total_time.count(), 1));
+	};
+	std::ostringstream oss;
+	oss << "phases:" << std::fixed << std::setprecision(1);
+	std::chrono::nanoseconds phases_total{ 0 };
+	for (const advent::phase_timing& phase : phases)
+	{
+		oss << ' ' << phase.name << ' ' << to_human_readable(phase.time) << " (" << get_percent(phase.time) << "%) |";
+		phases_total += phase.time;
+	}
+	const std::chrono::nanoseconds other_time = std::max(total_time - phases_total, std::chrono::nanoseconds{ 0 });
+	oss << " other " << to_human_readable(other_time) << " (" << get_percent(other_time) << "%)";
+	return oss.str();
+}
+
+test_result run_test(const verification_test& test, const verification_options& options, std::ostream& output)
+{
+	if (test.name.find(options.filter) == test.name.npos)
 	{
 		return test_result{
 			test.name,
@@ -151,16 +295,103 @@ test_result run_test(const verification_test& test, std::string_view filter)
 			test_status::filtered
 		};
 	}
-	std::cout << "Running test " << test.name << ": ";
-	const auto start_time = std::chrono::high_resolution_clock::now();
-	const auto res = test.test_func();
-	const auto end_time = std::chrono::high_resolution_clock::now();
-	const std::chrono::nanoseconds time_taken = end_time - start_time;
-	const auto string_result = to_string(res);
-	std::cout << "took " << to_human_readable(time_taken) <<  " and got " << string_result << '\n';
+	// Blocks the last test grew this thread's scratch arena to are given back, so one test's
+	// footprint isn't carried into the next, and a test's first run pays for its own blocks.
+	AdventCheck(utils::scratch_arena().bytes_used() == 0);
+	utils::scratch_arena().release();
+
+	output << "Running test " << test.name << ": ";
+	ADVENT_TRACE_SCOPE(test.name);
+
+	const auto test_start_time = std::chrono::steady_clock::now();
+	const advent::cancellation_scope cancellation{ options.test_timeout.count() > 0
+		? advent::cancellation_token{ test_start_time + options.test_timeout }
+		: advent::cancellation_token{} };
+
+	std::vector<std::chrono::nanoseconds> samples;
+	std::optional<ResultType> res;
+	advent::allocation_stats allocations;
+	std::optional<advent::counter_set> event_counters;
+	try
+	{
+		for (int i = 0; i < options.warmup_iterations; ++i)
+		{
+			test.test_func();
+		}
+
+		if (options.collect_counters)
+		{
+			event_counters.emplace();
+			event_counters->start();
+		}
+		advent::start_phase_collection();
+		const auto benchmark_start_time = std::chrono::high_resolution_clock::now();
+		do
+		{
+			advent::start_allocation_tracking();
+			const auto start_time = std::chrono::high_resolution_clock::now();
+			res = test.test_func();
+			const auto end_time = std::chrono::high_resolution_clock::now();
+			const advent::allocation_stats run_allocations = advent::stop_allocation_tracking();
+			samples.push_back(end_time - start_time);
+
+			// Counts are summed here and averaged below; the peak is the worst of any run.
+			allocations.allocations += run_allocations.allocations;
+			allocations.deallocations += run_allocations.deallocations;
+			allocations.bytes_allocated += run_allocations.bytes_allocated;
+			allocations.peak_live_bytes = std::max(allocations.peak_live_bytes, run_allocations.peak_live_bytes);
+		} while (static_cast<int>(samples.size()) < options.benchmark_iterations
+			|| std::chrono::high_resolution_clock::now() - benchmark_start_time < options.benchmark_min_time);
+	}
+	catch (const advent::test_timed_out&)
+	{
+		advent::stop_phase_collection();
+		advent::stop_allocation_tracking();
+		const auto time_taken = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - test_start_time);
+		output << "timed out after " << to_human_readable(time_taken) << '\n';
+		return test_result{ test.name,"",test.expected_result,test_status::timeout,time_taken };
+	}
+
+	std::vector<advent::phase_timing> phases = advent::stop_phase_collection();
+	advent::hardware_counters counters = event_counters.has_value() ? event_counters->stop() : advent::hardware_counters{};
+
+	const timing_statistics timings = get_timing_statistics(std::move(samples));
+	for (advent::phase_timing& phase : phases)
+	{
+		phase.time /= timings.num_samples;
+	}
+	allocations.allocations /= timings.num_samples;
+	allocations.deallocations /= timings.num_samples;
+	allocations.bytes_allocated /= timings.num_samples;
+	for (std::optional<std::uint64_t>* count : { &counters.cycles,&counters.instructions,&counters.l1d_misses,&counters.llc_misses,&counters.branch_misses })
+	{
+		if (count->has_value())
+		{
+			count->value() /= timings.num_samples;
+		}
+	}
+	const std::chrono::nanoseconds time_taken = timings.median;
+	const auto string_result = to_string(res.value());
+	output << "took " << to_human_readable(time_taken) <<  " and got " << string_result << '\n';
+	if (timings.num_samples > 1)
+	{
+		output << "    " << timing_statistics_to_string(timings) << '\n';
+	}
+	if (!phases.empty())
+	{
+		output << "    " << phases_to_string(phases, timings.mean) << '\n';
+	}
+	if constexpr (advent::allocation_tracking_enabled)
+	{
+		output << "    " << allocation_stats_to_string(allocations) << '\n';
+	}
+	if (counters.any())
+	{
+		output << "    " << hardware_counters_to_string(counters) << '\n';
+	}
 	auto get_result = [&](test_status status)
 	{
-		return test_result{ test.name,string_result,test.expected_result,status,time_taken };
+		return test_result{ test.name,string_result,test.expected_result,status,time_taken,timings,phases,allocations,counters };
 	};
 	if (test.result_known && string_result == test.expected_result)
 	{
@@ -173,12 +404,275 @@ test_result run_test(const verification_test& test, std::string_view filter)
 	return get_result(test_status::unknown);
 }
 
-bool verify_all(const std::string& filter)
+namespace
+{
+	using timing_history = std::map<std::string, std::chrono::nanoseconds, std::less<>>;
+
+	// Each line of the timings file is "<nanoseconds> <test name>".
+	timing_history load_timing_history(const std::string& filename)
+	{
+		timing_history result;
+		if (filename.empty())
+		{
+			return result;
+		}
+		std::ifstream file{ filename };
+		if (!file.is_open())
+		{
+			return result;
+		}
+		for (std::string_view line : utils::istream_line_range{ file })
+		{
+			if (line.empty()) continue;
+			const auto [time_str, name] = utils::split_string_at_first(line, ' ');
+			const auto time = utils::to_value<long long>(time_str);
+			result.insert_or_assign(std::string{ name }, std::chrono::nanoseconds{ time });
+		}
+		return result;
+	}
+
+	void save_timing_history(const std::string& filename, timing_history history, const test_result* first, const test_result* last)
+	{
+		if (filename.empty())
+		{
+			return;
+		}
+		std::for_each(first, last, [&history](const test_result& result)
+			{
+				if (result.status != test_status::filtered)
+				{
+					history.insert_or_assign(result.name, result.time_taken);
+				}
+			});
+		std::ofstream file{ filename };
+		for (const auto& [name, time] : history)
+		{
+			file << time.count() << ' ' << name << '\n';
+		}
+	}
+
+	// Orders test indices longest-first using previous timings. Tests we have never timed go
+	// to the front, as we have no reason to believe they are quick.
+	std::vector<std::size_t> get_schedule_order(const verification_test* first, const verification_test* last,
+		std::string_view filter, const timing_history& history)
+	{
+		std::vector<std::pair<std::chrono::nanoseconds, std::size_t>> timed_indices;
+		for (std::size_t idx = 0; first + idx != last; ++idx)
+		{
+			const verification_test& test = first[idx];
+			if (test.name.find(filter) == test.name.npos) continue;
+			const auto find_result = history.find(test.name);
+			const auto expected_time = find_result != end(history) ? find_result->second : std::chrono::nanoseconds::max();
+			timed_indices.emplace_back(expected_time, idx);
+		}
+		std::stable_sort(begin(timed_indices), end(timed_indices), [](const auto& left, const auto& right)
+			{
+				return left.first > right.first;
+			});
+		std::vector<std::size_t> result;
+		result.reserve(timed_indices.size());
+		std::transform(begin(timed_indices), end(timed_indices), std::back_inserter(result),
+			[](const auto& timed_idx) {return timed_idx.second; });
+		return result;
+	}
+
+	// Holds each test's console output until every test before it in the table has finished, so
+	// the log reads in table order no matter which order the tests complete in.
+	class ordered_output
+	{
+		std::mutex m_lock;
+		std::vector<std::optional<std::string>> m_buffers;
+		std::size_t m_next_to_print = 0;
+	public:
+		explicit ordered_output(std::size_t num_tests) : m_buffers(num_tests) {}
+		void complete(std::size_t idx, std::string output)
+		{
+			std::lock_guard guard{ m_lock };
+			m_buffers[idx] = std::move(output);
+			while (m_next_to_print < m_buffers.size() && m_buffers[m_next_to_print].has_value())
+			{
+				std::cout << m_buffers[m_next_to_print].value();
+				m_buffers[m_next_to_print].reset();
+				++m_next_to_print;
+			}
+		}
+	};
+
+	template <std::size_t NUM_TESTS>
+	void run_tests_in_parallel(std::array<test_result, NUM_TESTS>& results, const verification_options& options, const timing_history& history)
+	{
+		const std::vector<std::size_t> schedule = get_schedule_order(tests, tests + NUM_TESTS, options.filter, history);
+		const std::size_t num_runners = std::min<std::size_t>(std::max(options.num_jobs, 1), std::max<std::size_t>(schedule.size(), 1u));
+		ordered_output output{ NUM_TESTS };
+
+		// Filtered tests never get scheduled, but they still need a result and must not hold up the output.
+		for (std::size_t idx = 0; idx < NUM_TESTS; ++idx)
+		{
+			if (tests[idx].name.find(options.filter) == tests[idx].name.npos)
+			{
+				std::ostringstream ignored;
+				results[idx] = run_test(tests[idx], options, ignored);
+				output.complete(idx, "");
+			}
+		}
+
+		// Each runner takes the next test in schedule order, so the slowest start first. Runners are
+		// tasks on the shared thread pool, which is also what days use for their own parallel work,
+		// so running tests in parallel never puts more threads to work than the pool has.
+		std::atomic<std::size_t> next_in_schedule{ 0 };
+		auto runner = [&]()
+		{
+			for (std::size_t pos = next_in_schedule++; pos < schedule.size(); pos = next_in_schedule++)
+			{
+				const std::size_t idx = schedule[pos];
+				std::ostringstream test_output;
+				results[idx] = run_test(tests[idx], options, test_output);
+				output.complete(idx, test_output.str());
+			}
+		};
+
+		utils::task_group runners;
+		for (std::size_t i = 1; i < num_runners; ++i)
+		{
+			runners.run(runner);
+		}
+		runner();
+		runners.wait();
+	}
+
+	void report_regressions(const regression_check& check, const std::string& baseline_file)
+	{
+		std::cout << "REGRESSIONS (against " << baseline_file << "): " << check.regressions.size() << '\n';
+		for (const timing_regression& regression : check.regressions)
+		{
+			const double percent_change = 100.0 * static_cast<double>((regression.after.median - regression.before.median).count())
+				/ static_cast<double>(std::max<long long>(regression.before.median.count(), 1));
+			std::cout << "    " << regression.name << ": "
+				<< to_human_readable(regression.before.median) << " -> " << to_human_readable(regression.after.median)
+				<< " (+" << std::fixed << std::setprecision(1) << percent_change << "%, z=" << regression.z_score << ")\n"
+				<< std::defaultfloat;
+		}
+
+		// A gate that compared nothing would otherwise look just like one that passed.
+		if (check.num_too_few_samples > 0)
+		{
+			std::cout << "    WARNING: " << check.num_too_few_samples << " tests were not checked, as they had fewer than two"
+				" timed runs here or in the baseline. Use --repeat or --bench for both runs.\n";
+		}
+		if (check.num_not_in_baseline > 0)
+		{
+			std::cout << "    WARNING: " << check.num_not_in_baseline << " tests were not checked, as the baseline has no timings for them.\n";
+		}
+		if (check.num_compared == 0)
+		{
+			std::cout << "    WARNING: no tests could be compared against the baseline.\n";
+		}
+	}
+}
+
+bool verify_all(const verification_options& options)
 {
 	constexpr int NUM_TESTS = sizeof(tests) / sizeof(verification_test);
+	const std::string& filter = options.filter;
+	const timing_history history = load_timing_history(options.timings_file);
+	if (options.collect_counters)
+	{
+		if (const auto reason = advent::hardware_counters_unavailable_reason())
+		{
+			std::cout << "Hardware counters unavailable: " << reason.value() << '\n';
+		}
+		else
+		{
+			std::cout << "Hardware counters only count the thread running each test, so leave out days' work on the thread pool.\n";
+		}
+	}
+	if (!options.trace_file.empty())
+	{
+		if constexpr (advent::tracing_compiled_in)
+		{
+			advent::start_tracing();
+		}
+		else
+		{
+			std::cout << "Tracing is not compiled into this build, so no trace will be written.\n";
+		}
+	}
+
+	// Pinning only makes sense for one thread, so parallel runs are left to the scheduler.
+	const bool one_at_a_time = options.num_jobs <= 1;
+	if (!one_at_a_time && (options.pin_to_core >= 0 || options.raise_priority))
+	{
+		std::cout << "Core pinning and priority only apply when running one test at a time (--jobs 1).\n";
+	}
+
+	// New threads inherit their creator's affinity and priority. The pool's workers are started
+	// here, before this thread is isolated, so they stay free rather than being stuck on its core.
+	utils::thread_pool::global();
+	const advent::thread_isolation isolation{ one_at_a_time ? options.pin_to_core : -1, one_at_a_time && options.raise_priority };
+	if (one_at_a_time && options.pin_to_core >= 0 && !isolation.pinned())
+	{
+		std::cout << "Could not pin to core " << options.pin_to_core << ".\n";
+	}
+	if (one_at_a_time && options.raise_priority && !isolation.raised_priority())
+	{
+		std::cout << "Could not raise priority (this usually needs administrator or root rights).\n";
+	}
+
+	// Read after pinning so the governor is the pinned core's.
+	advent::host_info host = advent::get_host_info(isolation.pinned() ? isolation.core() : 0);
+	if (isolation.pinned())
+	{
+		host.pinned_core = isolation.core();
+	}
+	host.raised_priority = isolation.raised_priority();
+	if (isolation.pinned() || isolation.raised_priority())
+	{
+		std::cout << "HOST: " << (host.cpu_model.empty() ? std::string{ "unknown CPU" } : host.cpu_model)
+			<< ", " << host.logical_cores << " logical cores";
+		if (!host.governor.empty())
+		{
+			std::cout << ", governor " << host.governor;
+		}
+		if (host.turbo_enabled.has_value())
+		{
+			std::cout << ", turbo " << (host.turbo_enabled.value() ? "on" : "off");
+		}
+		if (host.load_average.has_value())
+		{
+			std::cout << ", load " << host.load_average.value();
+		}
+		std::cout << '\n';
+	}
+
 	std::array<test_result, NUM_TESTS> results;
-	std::transform(tests, tests + NUM_TESTS, begin(results),
-		std::bind(run_test,std::placeholders::_1,filter));
+	if (options.num_jobs > 1)
+	{
+		run_tests_in_parallel(results, options, history);
+	}
+	else
+	{
+		std::transform(tests, tests + NUM_TESTS, begin(results),
+			[&options](const verification_test& test)
+			{
+				return run_test(test, options, std::cout);
+			});
+	}
+	save_timing_history(options.timings_file, history, results.data(), results.data() + results.size());
+
+	if (advent::tracing_compiled_in && !options.trace_file.empty() && !advent::write_trace(options.trace_file))
+	{
+		std::cerr << "Could not write trace to " << options.trace_file << '\n';
+	}
+
+	if (!options.json_output_file.empty() && !write_results_json_lines(options.json_output_file, results.data(), results.data() + results.size(), host))
+	{
+		std::cerr << "Could not write results to " << options.json_output_file << '\n';
+	}
+	if (!options.csv_output_file.empty() && !write_results_csv(options.csv_output_file, results.data(), results.data() + results.size(), host))
+	{
+		std::cerr << "Could not write results to " << options.csv_output_file << '\n';
+	}
+
 	auto result_to_string = [&filter](const test_result& result)
 	{
 		std::ostringstream oss;
@@ -193,6 +687,9 @@ bool verify_all(const std::string& filter)
 			break;
 		case test_status::filtered:
 			return std::string{ "" };
+		case test_status::timeout:
+			oss << "TIMEOUT\n";
+			break;
 		default: // unknown
 			oss << "[Unknown]\n";
 			break;
@@ -215,8 +712,41 @@ bool verify_all(const std::string& filter)
 		"    PASSED : " << get_count(check_result<test_status::pass>) << "\n"
 		"    FAILED : " << get_count(check_result<test_status::fail>) << "\n"
 		"    UNKNOWN: " << get_count(check_result<test_status::unknown>) << "\n"
+		"    TIMEOUT: " << get_count(check_result<test_status::timeout>) << "\n"
 		"    TIME   : " << to_human_readable(total_time) << '\n';
-	return std::none_of(begin(results), end(results),check_result<test_status::fail>);
+
+	bool no_regressions = true;
+	if (!options.baseline_file.empty())
+	{
+		const std::optional<timing_baseline> baseline = read_baseline(options.baseline_file);
+		if (baseline.has_value())
+		{
+			const regression_check check = find_regressions(baseline.value(), results.data(), results.data() + results.size(),
+				options.regression_threshold, options.regression_min_slowdown);
+			report_regressions(check, options.baseline_file);
+			no_regressions = check.regressions.empty();
+		}
+		else
+		{
+			std::cout << "REGRESSIONS: could not read baseline " << options.baseline_file << ", so the run fails.\n";
+			no_regressions = false;
+		}
+	}
+	if (!options.save_baseline_file.empty() && !write_baseline(options.save_baseline_file, results.data(), results.data() + results.size()))
+	{
+		std::cerr << "Could not write baseline to " << options.save_baseline_file << '\n';
+	}
+
+	const bool no_failures = std::none_of(begin(results), end(results), check_result<test_status::fail>)
+		&& std::none_of(begin(results), end(results), check_result<test_status::timeout>);
+	return no_failures && no_regressions;
+}
+
+bool verify_all(const std::string& filter)
+{
+	verification_options options;
+	options.filter = filter;
+	return verify_all(options);
 }
 
 bool verify_all()
@@ -242,4 +772,32 @@ verification_test make_test(std::string name, TestFunc func, Dummy)
 verification_test make_test(std::string name, Dummy, Dummy)
 {
 	return make_test(std::move(name), []() { std::cout << "Test not implemented yet"; return ResultType{ 0 }; }, Dummy{});
+}
+
+namespace
+{
+	// Both-parts tests report their answers as one string, so they are checked like any other test.
+	std::string join_both_parts(const ResultType& part_one, const ResultType& part_two)
+	{
+		return to_string(part_one) + " | " + to_string(part_two);
+	}
+
+	TestFunc to_test_func(BothTestFunc func)
+	{
+		return [func = std::move(func)]()
+		{
+			const BothPartsResult result = func();
+			return ResultType{ join_both_parts(result.part_one, result.part_two) };
+		};
+	}
+}
+
+verification_test make_both_test(std::string name, BothTestFunc func, ResultType part_one_result, ResultType part_two_result)
+{
+	return make_test(std::move(name), to_test_func(std::move(func)), join_both_parts(part_one_result, part_two_result));
+}
+
+verification_test make_both_test(std::string name, BothTestFunc func, ResultType, Dummy)
+{
+	return make_test(std::move(name), to_test_func(std::move(func)), Dummy{});
 }
\ No newline at end of file
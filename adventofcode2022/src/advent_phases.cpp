@@ -0,0 +1,98 @@
+#include "../advent/advent_phases.h"
+
+#include <algorithm>
+
+#include "../advent/advent_trace.h"
+
+namespace
+{
+	struct phase_collection
+	{
+		bool collecting = false;
+		std::vector<advent::phase_timing> totals;
+		advent::phase_timer* current_phase = nullptr;
+	};
+
+	thread_local phase_collection this_thread_phases;
+
+	void add_phase_time(std::string_view name, std::chrono::nanoseconds time)
+	{
+		phase_collection& phases = this_thread_phases;
+		if (!phases.collecting)
+		{
+			return;
+		}
+		const auto find_result = std::find_if(begin(phases.totals), end(phases.totals),
+			[name](const advent::phase_timing& phase)
+			{
+				return phase.name == name;
+			});
+		if (find_result != end(phases.totals))
+		{
+			find_result->time += time;
+		}
+		else
+		{
+			phases.totals.push_back(advent::phase_timing{ name,time });
+		}
+	}
+}
+
+advent::phase_timer::phase_timer(std::string_view name)
+	: m_name{ name }
+	, m_parent{ this_thread_phases.current_phase }
+{
+	const auto now = clock::now();
+	if (m_parent != nullptr)
+	{
+		m_parent->record(now);
+	}
+	this_thread_phases.current_phase = this;
+	m_start = now;
+}
+
+advent::phase_timer::~phase_timer()
+{
+	const auto now = clock::now();
+	record(now);
+	this_thread_phases.current_phase = m_parent;
+	if (m_parent != nullptr)
+	{
+		m_parent->m_start = now;
+	}
+}
+
+void advent::phase_timer::record(clock::time_point now)
+{
+	const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_start);
+	add_phase_time(m_name, time);
+#if AOC_TRACE
+	// Phases show up in traces too, so there is no need to mark them twice.
+	if (advent::is_tracing())
+	{
+		const long long end_ns = advent::trace_now_ns();
+		advent::trace_complete(m_name, end_ns - time.count(), end_ns);
+	}
+#endif
+	m_start = now;
+}
+
+void advent::phase_timer::next(std::string_view name)
+{
+	record(clock::now());
+	m_name = name;
+}
+
+void advent::start_phase_collection()
+{
+	phase_collection& phases = this_thread_phases;
+	phases.collecting = true;
+	phases.totals.clear();
+}
+
+std::vector<advent::phase_timing> advent::stop_phase_collection()
+{
+	phase_collection& phases = this_thread_phases;
+	phases.collecting = false;
+	return std::move(phases.totals);
+}
\ No newline at end of file
@@ -0,0 +1,389 @@
+#include "../advent/advent_results.h"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "../advent/advent_assert.h"
+#include "../utils/istream_line_iterator.h"
+#include "../utils/split_string.h"
+#include "../utils/to_value.h"
+
+std::string_view to_string(test_status status)
+{
+	switch (status)
+	{
+	case test_status::pass:
+		return "pass";
+	case test_status::fail:
+		return "fail";
+	case test_status::unknown:
+		return "unknown";
+	case test_status::filtered:
+		return "filtered";
+	case test_status::timeout:
+		return "timeout";
+	default:
+		break;
+	}
+	AdventUnreachable();
+	return "";
+}
+
+std::string json_escape(std::string_view str)
+{
+	std::ostringstream oss;
+	oss << '"';
+	for (char c : str)
+	{
+		switch (c)
+		{
+		case '"':
+			oss << "\\\"";
+			break;
+		case '\\':
+			oss << "\\\\";
+			break;
+		case '\n':
+			oss << "\\n";
+			break;
+		case '\r':
+			oss << "\\r";
+			break;
+		case '\t':
+			oss << "\\t";
+			break;
+		default:
+			if (static_cast<unsigned char>(c) < 0x20)
+			{
+				oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+			}
+			else
+			{
+				oss << c;
+			}
+			break;
+		}
+	}
+	oss << '"';
+	return oss.str();
+}
+
+namespace
+{
+	// Quote fields containing separators, quotes or newlines, and double up embedded quotes.
+	std::string csv_escape(std::string_view str)
+	{
+		const bool needs_quotes = str.find_first_of(",\"\r\n") != str.npos;
+		if (!needs_quotes)
+		{
+			return std::string{ str };
+		}
+		std::string result{ '"' };
+		for (char c : str)
+		{
+			if (c == '"')
+			{
+				result.push_back('"');
+			}
+			result.push_back(c);
+		}
+		result.push_back('"');
+		return result;
+	}
+
+	// Phases go in a single field as "parse=123;solve=456".
+	std::string phases_to_csv_field(const test_result& result)
+	{
+		std::ostringstream oss;
+		for (const advent::phase_timing& phase : result.phases)
+		{
+			if (&phase != &result.phases.front())
+			{
+				oss << ';';
+			}
+			oss << phase.name << '=' << phase.time.count();
+		}
+		return csv_escape(oss.str());
+	}
+
+	// Counters that weren't collected are left out of JSON, and left empty in CSV.
+	void write_json_count(std::ostream& out, const char* name, const std::optional<std::uint64_t>& count)
+	{
+		if (count.has_value())
+		{
+			out << ",\"" << name << "\":" << count.value();
+		}
+	}
+
+	void write_csv_count(std::ostream& out, const std::optional<std::uint64_t>& count)
+	{
+		out << ',';
+		if (count.has_value())
+		{
+			out << count.value();
+		}
+	}
+
+	// The host is the same for every record, so is formatted once per file.
+	// Like counters, what couldn't be found out is left out of JSON and left empty in CSV.
+	std::string host_to_json(const advent::host_info& host)
+	{
+		std::ostringstream oss;
+		oss << std::boolalpha
+			<< "{\"cpu\":" << json_escape(host.cpu_model)
+			<< ",\"logical_cores\":" << host.logical_cores
+			<< ",\"governor\":" << json_escape(host.governor);
+		if (host.turbo_enabled.has_value())
+		{
+			oss << ",\"turbo\":" << host.turbo_enabled.value();
+		}
+		if (host.load_average.has_value())
+		{
+			oss << ",\"load_average\":" << host.load_average.value();
+		}
+		if (host.pinned_core.has_value())
+		{
+			oss << ",\"pinned_core\":" << host.pinned_core.value();
+		}
+		oss << ",\"raised_priority\":" << host.raised_priority << '}';
+		return oss.str();
+	}
+
+	std::string host_to_csv(const advent::host_info& host)
+	{
+		std::ostringstream oss;
+		oss << ',' << csv_escape(host.cpu_model)
+			<< ',' << host.logical_cores
+			<< ',' << csv_escape(host.governor) << ',';
+		if (host.turbo_enabled.has_value())
+		{
+			oss << (host.turbo_enabled.value() ? 1 : 0);
+		}
+		oss << ',';
+		if (host.load_average.has_value())
+		{
+			oss << host.load_average.value();
+		}
+		oss << ',';
+		if (host.pinned_core.has_value())
+		{
+			oss << host.pinned_core.value();
+		}
+		oss << ',' << (host.raised_priority ? 1 : 0);
+		return oss.str();
+	}
+
+	bool should_write(const test_result& result)
+	{
+		return result.status != test_status::filtered;
+	}
+}
+
+bool write_results_json_lines(const std::string& filename, const test_result* first, const test_result* last, const advent::host_info& host)
+{
+	std::ofstream file{ filename };
+	if (!file.is_open())
+	{
+		return false;
+	}
+	const std::string host_json = host_to_json(host);
+	std::for_each(first, last, [&file, &host_json](const test_result& result)
+		{
+			if (!should_write(result)) return;
+			const timing_statistics& timings = result.timings;
+			file << '{'
+				<< "\"name\":" << json_escape(result.name)
+				<< ",\"status\":" << json_escape(to_string(result.status))
+				<< ",\"result\":" << json_escape(result.result)
+				<< ",\"expected\":" << json_escape(result.expected)
+				<< ",\"time_ns\":" << result.time_taken.count()
+				<< ",\"samples\":" << timings.num_samples
+				<< ",\"min_ns\":" << timings.min.count()
+				<< ",\"median_ns\":" << timings.median.count()
+				<< ",\"mean_ns\":" << timings.mean.count()
+				<< ",\"p90_ns\":" << timings.p90.count()
+				<< ",\"p99_ns\":" << timings.p99.count()
+				<< ",\"cv\":" << timings.coefficient_of_variation
+				<< ",\"phases_ns\":{";
+			for (const advent::phase_timing& phase : result.phases)
+			{
+				if (&phase != &result.phases.front())
+				{
+					file << ',';
+				}
+				file << json_escape(phase.name) << ':' << phase.time.count();
+			}
+			file << '}';
+			if constexpr (advent::allocation_tracking_enabled)
+			{
+				const advent::allocation_stats& allocations = result.allocations;
+				file << ",\"allocations\":" << allocations.allocations
+					<< ",\"deallocations\":" << allocations.deallocations
+					<< ",\"bytes_allocated\":" << allocations.bytes_allocated
+					<< ",\"peak_bytes\":" << allocations.peak_live_bytes;
+			}
+			const advent::hardware_counters& counters = result.counters;
+			write_json_count(file, "cycles", counters.cycles);
+			write_json_count(file, "instructions", counters.instructions);
+			write_json_count(file, "l1d_misses", counters.l1d_misses);
+			write_json_count(file, "llc_misses", counters.llc_misses);
+			write_json_count(file, "branch_misses", counters.branch_misses);
+			file << ",\"host\":" << host_json << "}\n";
+		});
+	return true;
+}
+
+bool write_results_csv(const std::string& filename, const test_result* first, const test_result* last, const advent::host_info& host)
+{
+	std::ofstream file{ filename };
+	if (!file.is_open())
+	{
+		return false;
+	}
+	file << "name,status,result,expected,time_ns,samples,min_ns,median_ns,mean_ns,p90_ns,p99_ns,cv,phases_ns,allocations,deallocations,bytes_allocated,peak_bytes,cycles,instructions,l1d_misses,llc_misses,branch_misses,"
+		"cpu,logical_cores,governor,turbo,load_average,pinned_core,raised_priority\n";
+	const std::string host_csv = host_to_csv(host);
+	std::for_each(first, last, [&file, &host_csv](const test_result& result)
+		{
+			if (!should_write(result)) return;
+			const timing_statistics& timings = result.timings;
+			file << csv_escape(result.name)
+				<< ',' << to_string(result.status)
+				<< ',' << csv_escape(result.result)
+				<< ',' << csv_escape(result.expected)
+				<< ',' << result.time_taken.count()
+				<< ',' << timings.num_samples
+				<< ',' << timings.min.count()
+				<< ',' << timings.median.count()
+				<< ',' << timings.mean.count()
+				<< ',' << timings.p90.count()
+				<< ',' << timings.p99.count()
+				<< ',' << timings.coefficient_of_variation
+				<< ',' << phases_to_csv_field(result);
+			// The columns are always there so the layout doesn't depend on the build, but are left empty when nothing was counted.
+			if constexpr (advent::allocation_tracking_enabled)
+			{
+				const advent::allocation_stats& allocations = result.allocations;
+				file << ',' << allocations.allocations
+					<< ',' << allocations.deallocations
+					<< ',' << allocations.bytes_allocated
+					<< ',' << allocations.peak_live_bytes;
+			}
+			else
+			{
+				file << ",,,,";
+			}
+			const advent::hardware_counters& counters = result.counters;
+			write_csv_count(file, counters.cycles);
+			write_csv_count(file, counters.instructions);
+			write_csv_count(file, counters.l1d_misses);
+			write_csv_count(file, counters.llc_misses);
+			write_csv_count(file, counters.branch_misses);
+			file << host_csv << '\n';
+		});
+	return true;
+}
+
+std::optional<timing_baseline> read_baseline(const std::string& filename)
+{
+	std::ifstream file{ filename };
+	if (!file.is_open())
+	{
+		return std::nullopt;
+	}
+	timing_baseline result;
+	for (std::string_view line : utils::istream_line_range{ file })
+	{
+		if (line.empty()) continue;
+		const auto [median_str, rest_after_median] = utils::split_string_at_first(line, ' ');
+		const auto [std_dev_str, rest_after_std_dev] = utils::split_string_at_first(rest_after_median, ' ');
+		const auto [samples_str, name] = utils::split_string_at_first(rest_after_std_dev, ' ');
+		baseline_entry entry;
+		entry.median = std::chrono::nanoseconds{ utils::to_value<long long>(median_str) };
+		entry.std_dev = std::chrono::nanoseconds{ utils::to_value<long long>(std_dev_str) };
+		entry.num_samples = utils::to_value<std::size_t>(samples_str);
+		result.insert_or_assign(std::string{ name }, entry);
+	}
+	return result;
+}
+
+bool write_baseline(const std::string& filename, const test_result* first, const test_result* last)
+{
+	timing_baseline baseline = read_baseline(filename).value_or(timing_baseline{});
+	std::for_each(first, last, [&baseline](const test_result& result)
+		{
+			// Timed-out tests have no timings, so keep whatever the baseline had for them.
+			if (!should_write(result) || result.status == test_status::timeout) return;
+			baseline_entry entry;
+			entry.median = result.timings.median;
+			entry.std_dev = result.timings.std_dev;
+			entry.num_samples = result.timings.num_samples;
+			baseline.insert_or_assign(result.name, entry);
+		});
+
+	std::ofstream file{ filename };
+	if (!file.is_open())
+	{
+		return false;
+	}
+	for (const auto& [name, entry] : baseline)
+	{
+		file << entry.median.count() << ' ' << entry.std_dev.count() << ' ' << entry.num_samples << ' ' << name << '\n';
+	}
+	return true;
+}
+
+namespace
+{
+	// The standard error of a sample median is about sqrt(pi/2) times that of the mean.
+	double median_standard_error(std::chrono::nanoseconds std_dev, std::size_t num_samples)
+	{
+		constexpr double median_efficiency = 1.2533;
+		return median_efficiency * static_cast<double>(std_dev.count()) / std::sqrt(static_cast<double>(num_samples));
+	}
+}
+
+regression_check find_regressions(const timing_baseline& baseline, const test_result* first, const test_result* last,
+	double z_threshold, double min_relative_slowdown)
+{
+	regression_check result;
+	std::for_each(first, last, [&baseline, &result, z_threshold, min_relative_slowdown](const test_result& test)
+		{
+			if (!should_write(test)) return;
+			const auto find_result = baseline.find(test.name);
+			if (find_result == end(baseline))
+			{
+				++result.num_not_in_baseline;
+				return;
+			}
+
+			const baseline_entry& before = find_result->second;
+			const timing_statistics& after = test.timings;
+			if (before.num_samples < 2 || after.num_samples < 2)
+			{
+				++result.num_too_few_samples;
+				return;
+			}
+			++result.num_compared;
+
+			const double slowdown = static_cast<double>((after.median - before.median).count());
+			if (slowdown <= 0.0) return;
+			if (slowdown < min_relative_slowdown * static_cast<double>(before.median.count())) return;
+
+			const double before_error = median_standard_error(before.std_dev, before.num_samples);
+			const double after_error = median_standard_error(after.std_dev, after.num_samples);
+			const double combined_error = std::sqrt(before_error * before_error + after_error * after_error);
+
+			// With no measurable noise at all, any slowdown is significant.
+			const double z_score = combined_error > 0.0 ? slowdown / combined_error : std::numeric_limits<double>::infinity();
+			if (z_score > z_threshold)
+			{
+				result.regressions.push_back(timing_regression{ test.name, before, after, z_score });
+			}
+		});
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,249 @@
+#include "../advent/advent_scaling.h"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <numeric>
+#include <array>
+#include <cmath>
+#include <functional>
+
+#include "../advent/advent_solvers.h"
+#include "../advent/advent_generators.h"
+#include "../advent/advent_input.h"
+#include "../advent/advent_results.h"
+#include "../advent/advent_cancellation.h"
+#include "../advent/advent_assert.h"
+
+namespace
+{
+	struct scaling_day
+	{
+		int day;
+
+		// Sizes start here. Each day's is small enough that the first few doublings take
+		// milliseconds, so the suite reaches sizes well past the real input in reasonable time.
+		std::size_t base_size;
+	};
+
+	constexpr scaling_day scaling_days[] =
+	{
+		{ 1, 1000 },
+		{ 2, 4000 },
+		{ 3, 1200 },
+		{ 4, 2000 },
+		{ 5, 1000 },
+		{ 6, 8000 },
+		{ 7, 500 },
+		{ 8, 50 },
+		{ 9, 1000 },
+		{ 10, 500 },
+		{ 11, 16 },
+		{ 12, 32 },
+		{ 13, 100 },
+		{ 14, 50 },
+		{ 15, 4 },
+		{ 16, 4 },
+		{ 17, 1000 },
+		{ 18, 500 },
+		{ 19, 2 },
+		{ 20, 500 },
+		{ 21, 500 },
+		{ 22, 8 },
+		{ 23, 16 },
+		{ 24, 16 },
+		{ 25, 200 }
+	};
+
+	struct scaling_case
+	{
+		int day;
+		std::string_view name;
+		advent::solver_func solver;
+		std::size_t base_size;
+	};
+
+	struct growth_rate
+	{
+		std::string_view name;
+		double(*log_of)(double n);
+	};
+
+	// Logs of each growth rate, so they can be compared with log timings without overflowing.
+	// log n is kept at least 1 so small sizes don't divide by zero.
+	double log_of_log(double n) { return std::log(std::max(std::log2(n), 1.0)); }
+
+	const growth_rate growth_rates[] =
+	{
+		{ "O(1)", [](double) { return 0.0; } },
+		{ "O(log n)", [](double n) { return log_of_log(n); } },
+		{ "O(n)", [](double n) { return std::log(n); } },
+		{ "O(n log n)", [](double n) { return std::log(n) + log_of_log(n); } },
+		{ "O(n^2)", [](double n) { return 2.0 * std::log(n); } },
+		{ "O(n^2 log n)", [](double n) { return 2.0 * std::log(n) + log_of_log(n); } },
+		{ "O(n^3)", [](double n) { return 3.0 * std::log(n); } },
+		{ "O(2^n)", [](double n) { return n * std::log(2.0); } }
+	};
+
+	std::chrono::nanoseconds time_solver(const scaling_case& sc, const scaling_options& options)
+	{
+		std::vector<std::chrono::nanoseconds> samples;
+		const auto start_time = std::chrono::steady_clock::now();
+		do
+		{
+			const auto run_start = std::chrono::steady_clock::now();
+			sc.solver();
+			samples.push_back(std::chrono::steady_clock::now() - run_start);
+
+			// One slow run is enough to know the size is past the budget.
+			if (samples.back() > options.max_time_per_size) break;
+		} while (static_cast<int>(samples.size()) < options.repetitions
+			|| std::chrono::steady_clock::now() - start_time < options.min_time);
+		return get_timing_statistics(std::move(samples)).median;
+	}
+
+	scaling_result run_scaling_case(const scaling_case& sc, const scaling_options& options, std::ostream& output)
+	{
+		scaling_result result;
+		result.name = sc.name;
+		result.scale_description = advent::describe_input_scale(sc.day);
+		output << sc.name << " (n = " << result.scale_description << "):\n";
+
+		std::size_t size = sc.base_size;
+		for (int step = 0; step < options.num_sizes; ++step, size *= 2)
+		{
+			const std::string input = advent::generate_input(sc.day, size, options.seed);
+			const advent::puzzle_input_override input_override{ sc.day, input };
+
+			// Days check for cancellation in their long loops, so a size that blows up is stopped
+			// rather than left to run for hours.
+			const advent::cancellation_scope cancellation{ advent::cancellation_token{
+				std::chrono::steady_clock::now() + 4 * options.max_time_per_size } };
+			std::chrono::nanoseconds time{ 0 };
+			try
+			{
+				time = time_solver(sc, options);
+			}
+			catch (const advent::test_timed_out&)
+			{
+				output << "    " << std::setw(10) << size << "  timed out\n";
+				break;
+			}
+			catch (const advent::test_failed& failure)
+			{
+				result.error = failure.what();
+				output << "    " << std::setw(10) << size << "  failed: " << result.error << '\n';
+				break;
+			}
+			catch (const std::exception& ex)
+			{
+				result.error = ex.what();
+				output << "    " << std::setw(10) << size << "  failed: " << result.error << '\n';
+				break;
+			}
+
+			output << "    " << std::setw(10) << size << "  " << std::setw(10) << to_human_readable(time);
+			if (!result.times.empty())
+			{
+				const double ratio = static_cast<double>(time.count()) / static_cast<double>(std::max<long long>(result.times.back().count(), 1));
+				output << "  x" << std::fixed << std::setprecision(2) << ratio << std::defaultfloat;
+			}
+			output << '\n';
+			result.sizes.push_back(size);
+			result.times.push_back(time);
+
+			if (time > options.max_time_per_size) break;
+		}
+
+		fit_complexity(result);
+		if (!result.fits.empty())
+		{
+			output << "    exponent " << std::fixed << std::setprecision(2) << result.exponent << std::defaultfloat
+				<< ", best fit " << result.fits.front().name << '\n';
+		}
+		return result;
+	}
+}
+
+void fit_complexity(scaling_result& result)
+{
+	AdventCheck(result.sizes.size() == result.times.size());
+	result.fits.clear();
+	result.exponent = 0.0;
+	const std::size_t num_points = result.sizes.size();
+	if (num_points < 2)
+	{
+		return;
+	}
+
+	std::vector<double> log_sizes(num_points);
+	std::vector<double> log_times(num_points);
+	std::ranges::transform(result.sizes, begin(log_sizes), [](std::size_t size) { return std::log(static_cast<double>(size)); });
+	std::ranges::transform(result.times, begin(log_times),
+		[](std::chrono::nanoseconds time) { return std::log(static_cast<double>(std::max<long long>(time.count(), 1))); });
+
+	// Least-squares slope through the log-log points.
+	const double mean_log_size = std::reduce(begin(log_sizes), end(log_sizes)) / static_cast<double>(num_points);
+	const double mean_log_time = std::reduce(begin(log_times), end(log_times)) / static_cast<double>(num_points);
+	double covariance = 0.0;
+	double size_variance = 0.0;
+	for (std::size_t i = 0; i < num_points; ++i)
+	{
+		covariance += (log_sizes[i] - mean_log_size) * (log_times[i] - mean_log_time);
+		size_variance += (log_sizes[i] - mean_log_size) * (log_sizes[i] - mean_log_size);
+	}
+	result.exponent = size_variance > 0.0 ? covariance / size_variance : 0.0;
+
+	// For each growth rate f, time = c * f(n) becomes log(time) - log(f(n)) = log(c), so the best c
+	// is the mean of the differences and how well f fits is how far they spread around it.
+	for (const growth_rate& rate : growth_rates)
+	{
+		std::vector<double> differences(num_points);
+		for (std::size_t i = 0; i < num_points; ++i)
+		{
+			differences[i] = log_times[i] - rate.log_of(static_cast<double>(result.sizes[i]));
+		}
+		const double mean_difference = std::reduce(begin(differences), end(differences)) / static_cast<double>(num_points);
+		const double sum_of_squares = std::transform_reduce(begin(differences), end(differences), 0.0, std::plus<double>{},
+			[mean_difference](double difference) { return (difference - mean_difference) * (difference - mean_difference); });
+		result.fits.push_back(complexity_fit{ rate.name, std::sqrt(sum_of_squares / static_cast<double>(num_points)) });
+	}
+	std::ranges::sort(result.fits, {}, &complexity_fit::residual);
+}
+
+bool run_scaling_suite(const scaling_options& options)
+{
+	std::vector<scaling_result> results;
+	for (const scaling_day& sd : scaling_days)
+	{
+		for (int part : { 1, 2 })
+		{
+			const scaling_case sc{ sd.day, advent::get_solver_name(sd.day, part), advent::get_solver(sd.day, part), sd.base_size };
+			if (sc.name.find(options.filter) == std::string_view::npos) continue;
+			results.push_back(run_scaling_case(sc, options, std::cout));
+		}
+	}
+
+	std::cout << "SCALING:\n";
+	for (const scaling_result& result : results)
+	{
+		std::cout << "    " << std::left << std::setw(22) << result.name << std::right;
+		if (!result.error.empty())
+		{
+			std::cout << "failed: " << result.error << '\n';
+		}
+		else if (result.fits.empty())
+		{
+			std::cout << "too few sizes to fit\n";
+		}
+		else
+		{
+			std::cout << "n^" << std::fixed << std::setprecision(2) << result.exponent << std::defaultfloat
+				<< "  " << std::left << std::setw(14) << result.fits.front().name << std::right
+				<< "(n = " << result.scale_description << ")\n";
+		}
+	}
+
+	return std::ranges::none_of(results, [](const scaling_result& result) { return !result.error.empty(); });
+}
\ No newline at end of file
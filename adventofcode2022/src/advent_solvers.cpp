@@ -0,0 +1,227 @@
+#include "../advent/advent_solvers.h"
+
+#include <array>
+#include <sstream>
+#include <exception>
+
+#include "../advent/advent_headers.h"
+#include "../advent/advent_input.h"
+#include "../advent/advent_results.h"
+#include "../advent/advent_cancellation.h"
+#include "../advent/advent_assert.h"
+
+namespace
+{
+	struct day_solvers
+	{
+		std::array<std::string_view, 2> names;
+		std::array<advent::solver_func, 2> solvers;
+		advent::both_solver_func both_solver;
+	};
+
+#define SOLVER_PARTS(day_name) \
+	{ "advent_" #day_name "_p1", "advent_" #day_name "_p2" }, { advent_ ## day_name ## _p1, advent_ ## day_name ## _p2 }
+
+	// Days without a function for both parts solve them one after the other.
+#define SOLVER_DAY(day_name) \
+	day_solvers{ SOLVER_PARTS(day_name), []() { return BothPartsResult{ advent_ ## day_name ## _p1(), advent_ ## day_name ## _p2() }; } }
+
+#define SOLVER_DAY_WITH_BOTH(day_name) \
+	day_solvers{ SOLVER_PARTS(day_name), advent_ ## day_name ## _both }
+
+	const std::array<day_solvers, advent::last_solved_day> all_solvers{ {
+		SOLVER_DAY(one),
+		SOLVER_DAY(two),
+		SOLVER_DAY(three),
+		SOLVER_DAY(four),
+		SOLVER_DAY(five),
+		SOLVER_DAY(six),
+		SOLVER_DAY(seven),
+		SOLVER_DAY(eight),
+		SOLVER_DAY(nine),
+		SOLVER_DAY(ten),
+		SOLVER_DAY(eleven),
+		SOLVER_DAY(twelve),
+		SOLVER_DAY(thirteen),
+		SOLVER_DAY(fourteen),
+		SOLVER_DAY(fifteen),
+		SOLVER_DAY_WITH_BOTH(sixteen),
+		SOLVER_DAY(seventeen),
+		SOLVER_DAY(eighteen),
+		SOLVER_DAY(nineteen),
+		SOLVER_DAY(twenty),
+		SOLVER_DAY(twentyone),
+		SOLVER_DAY_WITH_BOTH(twentytwo),
+		SOLVER_DAY(twentythree),
+		SOLVER_DAY_WITH_BOTH(twentyfour),
+		SOLVER_DAY(twentyfive)
+	} };
+
+#undef SOLVER_DAY_WITH_BOTH
+#undef SOLVER_DAY
+#undef SOLVER_PARTS
+
+	bool is_valid_day(int day)
+	{
+		return day >= advent::first_solved_day && day <= advent::last_solved_day;
+	}
+
+	bool is_valid(int day, int part)
+	{
+		return is_valid_day(day) && (part == 1 || part == 2);
+	}
+
+	const day_solvers& get_day(int day)
+	{
+		return all_solvers[static_cast<std::size_t>(day - advent::first_solved_day)];
+	}
+
+	std::string_view trim_trailing_newlines(std::string_view input)
+	{
+		while (!input.empty() && (input.back() == '\n' || input.back() == '\r'))
+		{
+			input.remove_suffix(1);
+		}
+		return input;
+	}
+
+	// Calls solve and fills in outcome's status, time and error. solve keeps its own answers.
+	// The day's input must already be overridden with the one to solve.
+	template <typename SolveFunc>
+	void run_solver(std::chrono::milliseconds timeout, advent::solve_outcome& outcome, SolveFunc solve)
+	{
+		const auto start_time = std::chrono::steady_clock::now();
+		const advent::cancellation_scope cancellation{ timeout.count() > 0
+			? advent::cancellation_token{ start_time + timeout }
+			: advent::cancellation_token{} };
+		try
+		{
+			solve();
+			outcome.time = std::chrono::steady_clock::now() - start_time;
+			outcome.status = advent::solve_status::ok;
+		}
+		catch (const advent::test_timed_out&)
+		{
+			outcome.time = std::chrono::steady_clock::now() - start_time;
+			outcome.status = advent::solve_status::timeout;
+		}
+		catch (const advent::test_failed& failure)
+		{
+			outcome.error = failure.what();
+		}
+		catch (const std::exception& ex)
+		{
+			outcome.error = ex.what();
+		}
+	}
+}
+
+advent::solver_func advent::get_solver(int day, int part)
+{
+	if (!is_valid(day, part))
+	{
+		return nullptr;
+	}
+	return get_day(day).solvers[static_cast<std::size_t>(part - 1)];
+}
+
+std::string_view advent::get_solver_name(int day, int part)
+{
+	if (!is_valid(day, part))
+	{
+		return "";
+	}
+	return get_day(day).names[static_cast<std::size_t>(part - 1)];
+}
+
+std::string_view advent::to_string(solve_status status)
+{
+	switch (status)
+	{
+	case solve_status::ok:
+		return "ok";
+	case solve_status::error:
+		return "error";
+	case solve_status::timeout:
+		return "timeout";
+	default:
+		break;
+	}
+	AdventUnreachable();
+	return "";
+}
+
+advent::both_solver_func advent::get_both_solver(int day)
+{
+	if (!is_valid_day(day))
+	{
+		return nullptr;
+	}
+	return get_day(day).both_solver;
+}
+
+advent::solve_outcome advent::solve_input(int day, int part, std::string_view input, std::chrono::milliseconds timeout)
+{
+	solve_outcome outcome;
+	const solver_func solver = get_solver(day, part);
+	if (solver == nullptr)
+	{
+		std::ostringstream message;
+		message << "There is no solver for day " << day << " part " << part;
+		outcome.error = message.str();
+		return outcome;
+	}
+
+	const puzzle_input_override input_override{ day, trim_trailing_newlines(input) };
+	run_solver(timeout, outcome, [solver, &outcome]()
+		{
+			outcome.result = ::to_string(solver());
+		});
+	return outcome;
+}
+
+advent::solve_outcome advent::solve_stream(int day, int part, std::istream& input, std::chrono::milliseconds timeout)
+{
+	solve_outcome outcome;
+	const solver_func solver = get_solver(day, part);
+	if (solver == nullptr)
+	{
+		std::ostringstream message;
+		message << "There is no solver for day " << day << " part " << part;
+		outcome.error = message.str();
+		return outcome;
+	}
+
+	const puzzle_input_override input_override{ day, input };
+	run_solver(timeout, outcome, [solver, &outcome]()
+		{
+			outcome.result = ::to_string(solver());
+		});
+	return outcome;
+}
+
+std::array<advent::solve_outcome, 2> advent::solve_both_input(int day, std::string_view input, std::chrono::milliseconds timeout)
+{
+	std::array<solve_outcome, 2> outcomes;
+	const both_solver_func solver = get_both_solver(day);
+	if (solver == nullptr)
+	{
+		std::ostringstream message;
+		message << "There is no solver for day " << day;
+		outcomes[0].error = message.str();
+		outcomes[1] = outcomes[0];
+		return outcomes;
+	}
+
+	std::string part_two_result;
+	const puzzle_input_override input_override{ day, trim_trailing_newlines(input) };
+	run_solver(timeout, outcomes[0], [solver, &outcomes, &part_two_result]()
+		{
+			const BothPartsResult result = solver();
+			outcomes[0].result = ::to_string(result.part_one);
+			part_two_result = ::to_string(result.part_two);
+		});
+	outcomes[1] = outcomes[0];
+	outcomes[1].result = std::move(part_two_result);
+	return outcomes;
+}
\ No newline at end of file
@@ -0,0 +1,279 @@
+#include "../advent/advent_trace.h"
+
+#include <iostream>
+#include <streambuf>
+
+#if AOC_TRACE
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../advent/advent_results.h"
+
+namespace
+{
+	struct trace_event
+	{
+		std::string_view name;
+		// Chrome trace-event phase: 'X' for a complete span, 'C' for a counter, 'i' for an instant.
+		char phase;
+		long long timestamp_ns;
+		long long duration_ns;
+		double value;
+	};
+
+	struct thread_trace
+	{
+		int thread_id;
+		std::vector<trace_event> events;
+		// Text for events whose names had to be copied. Strings in a deque never move, so the
+		// events' views of them stay valid.
+		std::deque<std::string> messages;
+	};
+
+	class trace_recorder
+	{
+		std::mutex m_lock;
+		// Never freed, so threads can keep pointers to their own buffer.
+		std::vector<std::unique_ptr<thread_trace>> m_threads;
+		std::atomic<bool> m_active{ false };
+		std::chrono::steady_clock::time_point m_epoch = std::chrono::steady_clock::now();
+	public:
+		bool is_active() const
+		{
+			return m_active.load(std::memory_order_relaxed);
+		}
+
+		long long now_ns() const
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_epoch).count();
+		}
+
+		void start()
+		{
+			std::lock_guard guard{ m_lock };
+			for (const std::unique_ptr<thread_trace>& thread : m_threads)
+			{
+				thread->events.clear();
+				thread->messages.clear();
+			}
+			m_active = true;
+		}
+
+		// Must only be called once every thread that recorded events has finished with them.
+		bool write(const std::string& filename);
+
+		thread_trace& get_this_thread()
+		{
+			thread_local thread_trace* this_thread = nullptr;
+			if (this_thread == nullptr)
+			{
+				std::lock_guard guard{ m_lock };
+				m_threads.push_back(std::make_unique<thread_trace>());
+				this_thread = m_threads.back().get();
+				this_thread->thread_id = static_cast<int>(m_threads.size());
+			}
+			return *this_thread;
+		}
+
+		void record(const trace_event& event)
+		{
+			if (is_active())
+			{
+				get_this_thread().events.push_back(event);
+			}
+		}
+
+		void record_message(std::string_view text)
+		{
+			if (is_active())
+			{
+				thread_trace& thread = get_this_thread();
+				const std::string& stored = thread.messages.emplace_back(text);
+				thread.events.push_back(trace_event{ stored, 'i', now_ns(), 0, 0.0 });
+			}
+		}
+	};
+
+	trace_recorder& get_trace_recorder()
+	{
+		static trace_recorder recorder;
+		return recorder;
+	}
+
+	bool trace_recorder::write(const std::string& filename)
+	{
+		std::lock_guard guard{ m_lock };
+		m_active = false;
+		std::ofstream file{ filename };
+		if (!file.is_open())
+		{
+			return false;
+		}
+		// Chrome wants microseconds; fractions keep the nanosecond detail.
+		auto to_us = [](long long ns)
+		{
+			return static_cast<double>(ns) / 1000.0;
+		};
+		file << std::fixed;
+		file.precision(3);
+		file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+		bool first = true;
+		for (const std::unique_ptr<thread_trace>& thread : m_threads)
+		{
+			for (const trace_event& event : thread->events)
+			{
+				file << (first ? "\n" : ",\n");
+				first = false;
+				file << "{\"name\":" << json_escape(event.name)
+					<< ",\"ph\":\"" << event.phase << '"'
+					<< ",\"ts\":" << to_us(event.timestamp_ns)
+					<< ",\"pid\":1,\"tid\":" << thread->thread_id;
+				switch (event.phase)
+				{
+				case 'X':
+					file << ",\"dur\":" << to_us(event.duration_ns);
+					break;
+				case 'C':
+					file << ",\"args\":{\"value\":" << event.value << '}';
+					break;
+				case 'i':
+					file << ",\"s\":\"t\"";
+					break;
+				default:
+					break;
+				}
+				file << '}';
+			}
+			thread->events.clear();
+			thread->messages.clear();
+		}
+		file << "\n]}\n";
+		return true;
+	}
+}
+
+void advent::start_tracing()
+{
+	get_trace_recorder().start();
+}
+
+bool advent::write_trace(const std::string& filename)
+{
+	return get_trace_recorder().write(filename);
+}
+
+bool advent::is_tracing()
+{
+	return get_trace_recorder().is_active();
+}
+
+long long advent::trace_now_ns()
+{
+	return get_trace_recorder().now_ns();
+}
+
+advent::trace_span::trace_span(std::string_view name)
+	: m_name{ name }
+	, m_start_ns{ is_tracing() ? trace_now_ns() : -1 }
+{
+}
+
+advent::trace_span::~trace_span()
+{
+	if (m_start_ns >= 0)
+	{
+		trace_complete(m_name, m_start_ns, trace_now_ns());
+	}
+}
+
+void advent::trace_complete(std::string_view name, long long start_ns, long long end_ns)
+{
+	get_trace_recorder().record(trace_event{ name, 'X', start_ns, end_ns - start_ns, 0.0 });
+}
+
+void advent::trace_counter(std::string_view name, double value)
+{
+	trace_recorder& recorder = get_trace_recorder();
+	if (recorder.is_active())
+	{
+		recorder.record(trace_event{ name, 'C', recorder.now_ns(), 0, value });
+	}
+}
+
+void advent::trace_instant(std::string_view name)
+{
+	trace_recorder& recorder = get_trace_recorder();
+	if (recorder.is_active())
+	{
+		recorder.record(trace_event{ name, 'i', recorder.now_ns(), 0, 0.0 });
+	}
+}
+
+void advent::trace_message(std::string_view text)
+{
+	get_trace_recorder().record_message(text);
+}
+
+#else
+
+void advent::start_tracing()
+{
+}
+
+bool advent::write_trace(const std::string&)
+{
+	return false;
+}
+
+#endif
+
+namespace
+{
+	// Unbuffered, so output interleaves with anything written to std::cout directly.
+	class debug_log_buffer : public std::streambuf
+	{
+	protected:
+		int_type overflow(int_type c) override
+		{
+			if (traits_type::eq_int_type(c, traits_type::eof()))
+			{
+				return traits_type::not_eof(c);
+			}
+			const char ch = traits_type::to_char_type(c);
+#if AOC_TRACE
+			if (advent::is_tracing())
+			{
+				thread_local std::string line;
+				if (ch != '\n')
+				{
+					line.push_back(ch);
+				}
+				else if (!line.empty())
+				{
+					advent::trace_message(line);
+					line.clear();
+				}
+			}
+#endif
+			return std::cout.rdbuf()->sputc(ch);
+		}
+
+		int sync() override
+		{
+			return std::cout.rdbuf()->pubsync();
+		}
+	};
+}
+
+std::ostream& advent::debug_log()
+{
+	static debug_log_buffer buffer;
+	static std::ostream stream{ &buffer };
+	return stream;
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "../utils/arena_resource.h"
+
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+
+#include "../advent/advent_assert.h"
+
+namespace
+{
+	std::size_t align_up(std::size_t value, std::size_t alignment) noexcept
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+}
+
+utils::arena_resource::arena_resource(std::size_t initial_block_size, std::pmr::memory_resource* upstream) noexcept
+	: m_upstream{ upstream }
+	, m_initial_block_size{ std::max<std::size_t>(initial_block_size, 64) }
+{
+}
+
+void* utils::arena_resource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+	if (m_current_block < m_blocks.size())
+	{
+		const block& current = m_blocks[m_current_block];
+		const std::size_t start = align_up(m_offset, alignment);
+		if (start + bytes <= current.size)
+		{
+			m_offset = start + bytes;
+			return current.memory + start;
+		}
+	}
+
+	// Move on to the next block kept from before a rewind if it suits. Otherwise put a new one in
+	// its place, twice the size of the last so the number of blocks stays small.
+	const std::size_t next_block = m_blocks.empty() ? 0 : m_current_block + 1;
+	auto can_reuse = [this, next_block, bytes, alignment]()
+	{
+		if (next_block >= m_blocks.size()) return false;
+		const block& kept = m_blocks[next_block];
+		return kept.size >= bytes && reinterpret_cast<std::uintptr_t>(kept.memory) % alignment == 0;
+	};
+	if (!can_reuse())
+	{
+		const std::size_t previous_size = m_blocks.empty() ? m_initial_block_size / 2 : m_blocks.back().size;
+		const std::size_t new_size = std::max(previous_size * 2, align_up(bytes, alignof(std::max_align_t)));
+		const std::size_t new_alignment = std::max(alignment, alignof(std::max_align_t));
+		std::byte* const memory = static_cast<std::byte*>(m_upstream->allocate(new_size, new_alignment));
+		m_blocks.insert(m_blocks.begin() + static_cast<std::ptrdiff_t>(next_block), block{ memory, new_size, new_alignment });
+	}
+
+	m_current_block = next_block;
+	m_offset = bytes;
+	return m_blocks[next_block].memory;
+}
+
+void utils::arena_resource::rewind(checkpoint to)
+{
+	AdventCheck(to.block < m_current_block || (to.block == m_current_block && to.offset <= m_offset));
+	m_current_block = to.block;
+	m_offset = to.offset;
+}
+
+void utils::arena_resource::release() noexcept
+{
+	for (const block& b : m_blocks)
+	{
+		m_upstream->deallocate(b.memory, b.size, b.alignment);
+	}
+	m_blocks.clear();
+	m_current_block = 0;
+	m_offset = 0;
+}
+
+std::size_t utils::arena_resource::bytes_used() const noexcept
+{
+	if (m_blocks.empty())
+	{
+		return 0;
+	}
+	const auto current = m_blocks.begin() + static_cast<std::ptrdiff_t>(m_current_block);
+	return std::accumulate(m_blocks.begin(), current, m_offset,
+		[](std::size_t total, const block& b) { return total + b.size; });
+}
+
+std::size_t utils::arena_resource::bytes_reserved() const noexcept
+{
+	return std::accumulate(m_blocks.begin(), m_blocks.end(), std::size_t{ 0 },
+		[](std::size_t total, const block& b) { return total + b.size; });
+}
+
+utils::arena_resource& utils::scratch_arena() noexcept
+{
+	thread_local arena_resource arena;
+	return arena;
+}
\ No newline at end of file
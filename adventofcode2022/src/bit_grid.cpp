@@ -0,0 +1,173 @@
+#include "../utils/bit_grid.h"
+
+#include <algorithm>
+#include <bit>
+#include <numeric>
+
+#include "../advent/advent_assert.h"
+
+utils::bit_grid::bit_grid(utils::coords size, bool initial_value)
+	: m_size{ size }
+	, m_words_per_row{ (static_cast<std::size_t>(size.x) + bits_per_word - 1) / bits_per_word }
+{
+	AdventCheck(size.x >= 0 && size.y >= 0);
+	m_words.resize(m_words_per_row * static_cast<std::size_t>(size.y));
+	fill(initial_value);
+}
+
+utils::bit_grid::word_type utils::bit_grid::last_word_mask() const noexcept
+{
+	const int used_bits = m_size.x % bits_per_word;
+	return used_bits == 0 ? ~word_type{ 0 } : (word_type{ 1 } << used_bits) - 1;
+}
+
+void utils::bit_grid::clear_padding() noexcept
+{
+	if (m_words_per_row == 0)
+	{
+		return;
+	}
+	const word_type mask = last_word_mask();
+	for (std::size_t idx = m_words_per_row - 1; idx < m_words.size(); idx += m_words_per_row)
+	{
+		m_words[idx] &= mask;
+	}
+}
+
+bool utils::bit_grid::is_on_grid(utils::coords coords) const noexcept
+{
+	return coords.x >= 0 && coords.y >= 0 && coords.x < m_size.x && coords.y < m_size.y;
+}
+
+bool utils::bit_grid::get(utils::coords coords) const
+{
+	AdventCheck(is_on_grid(coords));
+	const std::size_t x = static_cast<std::size_t>(coords.x);
+	return ((row(coords.y)[x / bits_per_word] >> (x % bits_per_word)) & 1) != 0;
+}
+
+void utils::bit_grid::set(utils::coords coords, bool value)
+{
+	AdventCheck(is_on_grid(coords));
+	const std::size_t x = static_cast<std::size_t>(coords.x);
+	word_type& word = row(coords.y)[x / bits_per_word];
+	const word_type bit = word_type{ 1 } << (x % bits_per_word);
+	word = value ? (word | bit) : (word & ~bit);
+}
+
+void utils::bit_grid::fill(bool value)
+{
+	std::ranges::fill(m_words, value ? ~word_type{ 0 } : word_type{ 0 });
+	clear_padding();
+}
+
+std::span<utils::bit_grid::word_type> utils::bit_grid::row(int y)
+{
+	AdventCheck(y >= 0 && y < m_size.y);
+	return std::span<word_type>{ m_words.data() + static_cast<std::size_t>(y) * m_words_per_row, m_words_per_row };
+}
+
+std::span<const utils::bit_grid::word_type> utils::bit_grid::row(int y) const
+{
+	AdventCheck(y >= 0 && y < m_size.y);
+	return std::span<const word_type>{ m_words.data() + static_cast<std::size_t>(y) * m_words_per_row, m_words_per_row };
+}
+
+utils::bit_grid::word_type utils::bit_grid::get_bits(int x, int y, int count) const
+{
+	AdventCheck(count >= 0 && count <= bits_per_word);
+	if (count == 0 || y < 0 || y >= m_size.y || x >= m_size.x || x + count <= 0)
+	{
+		return 0;
+	}
+
+	// Read from x onwards as if the row carried on with zeros either side of it.
+	const std::span<const word_type> words = row(y);
+	auto word_at = [&words](std::ptrdiff_t idx) -> word_type
+	{
+		return idx >= 0 && idx < static_cast<std::ptrdiff_t>(words.size()) ? words[static_cast<std::size_t>(idx)] : 0;
+	};
+	const std::ptrdiff_t first_word = (x >= 0 ? x : x - (bits_per_word - 1)) / bits_per_word;
+	const int shift = x - static_cast<int>(first_word) * bits_per_word;
+	word_type result = word_at(first_word) >> shift;
+	if (shift != 0)
+	{
+		result |= word_at(first_word + 1) << (bits_per_word - shift);
+	}
+	return count == bits_per_word ? result : result & ((word_type{ 1 } << count) - 1);
+}
+
+std::uint16_t utils::bit_grid::neighbour_mask(utils::coords centre) const
+{
+	std::uint16_t result = 0;
+	for (int dy = -1; dy <= 1; ++dy)
+	{
+		const word_type bits = get_bits(centre.x - 1, centre.y + dy, 3);
+		result |= static_cast<std::uint16_t>(bits << ((dy + 1) * 3));
+	}
+	return result;
+}
+
+std::size_t utils::bit_grid::count() const noexcept
+{
+	return std::accumulate(begin(m_words), end(m_words), std::size_t{ 0 },
+		[](std::size_t total, word_type word) { return total + static_cast<std::size_t>(std::popcount(word)); });
+}
+
+std::size_t utils::bit_grid::count_row(int y) const
+{
+	const std::span<const word_type> words = row(y);
+	return std::accumulate(words.begin(), words.end(), std::size_t{ 0 },
+		[](std::size_t total, word_type word) { return total + static_cast<std::size_t>(std::popcount(word)); });
+}
+
+bool utils::bit_grid::any() const noexcept
+{
+	return std::ranges::any_of(m_words, [](word_type word) { return word != 0; });
+}
+
+utils::bit_grid& utils::bit_grid::operator&=(const bit_grid& other)
+{
+	AdventCheck(check_same_size(other));
+	std::ranges::transform(m_words, other.m_words, begin(m_words), [](word_type l, word_type r) { return l & r; });
+	return *this;
+}
+
+utils::bit_grid& utils::bit_grid::operator|=(const bit_grid& other)
+{
+	AdventCheck(check_same_size(other));
+	std::ranges::transform(m_words, other.m_words, begin(m_words), [](word_type l, word_type r) { return l | r; });
+	return *this;
+}
+
+utils::bit_grid& utils::bit_grid::operator^=(const bit_grid& other)
+{
+	AdventCheck(check_same_size(other));
+	std::ranges::transform(m_words, other.m_words, begin(m_words), [](word_type l, word_type r) { return l ^ r; });
+	return *this;
+}
+
+utils::bit_grid& utils::bit_grid::and_not(const bit_grid& other)
+{
+	AdventCheck(check_same_size(other));
+	std::ranges::transform(m_words, other.m_words, begin(m_words), [](word_type l, word_type r) { return l & ~r; });
+	return *this;
+}
+
+utils::bit_grid utils::bit_grid::shifted(utils::coords offset) const
+{
+	bit_grid result{ m_size };
+	for (int y = std::max(0, offset.y); y < std::min(m_size.y, m_size.y + offset.y); ++y)
+	{
+		// The cell at x in the new row comes from x - offset.x in the old one, so each new word
+		// is the 64 old cells starting there.
+		const int source_y = y - offset.y;
+		const std::span<word_type> words = result.row(y);
+		for (std::size_t idx = 0; idx < words.size(); ++idx)
+		{
+			words[idx] = get_bits(static_cast<int>(idx) * bits_per_word - offset.x, source_y, bits_per_word);
+		}
+	}
+	result.clear_padding();
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "../utils/mapped_file.h"
+
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#include "../advent/advent_assert.h"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#define MAPPED_FILE_WIN32 1
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_POSIX 1
+#endif
+
+utils::mapped_file::mapped_file(const std::string& filename)
+{
+	if (map(filename))
+	{
+		return;
+	}
+	AdventCheckMsg(read(filename), "Could not open input file ", filename);
+}
+
+utils::mapped_file::mapped_file(mapped_file&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+utils::mapped_file& utils::mapped_file::operator=(mapped_file&& other) noexcept
+{
+	if (this == &other)
+	{
+		return *this;
+	}
+	release();
+	const bool other_uses_fallback = other.m_mapping == nullptr && other.m_data == other.m_fallback.data();
+	m_mapping = std::exchange(other.m_mapping, nullptr);
+	m_size = std::exchange(other.m_size, 0);
+	m_fallback = std::move(other.m_fallback);
+	m_data = other_uses_fallback ? m_fallback.data() : other.m_data;
+	other.m_data = nullptr;
+	return *this;
+}
+
+void utils::mapped_file::release() noexcept
+{
+	if (m_mapping != nullptr)
+	{
+#if MAPPED_FILE_WIN32
+		UnmapViewOfFile(m_data);
+		CloseHandle(static_cast<HANDLE>(m_mapping));
+#elif MAPPED_FILE_POSIX
+		munmap(m_mapping, m_size);
+#endif
+	}
+	m_mapping = nullptr;
+	m_data = nullptr;
+	m_size = 0;
+	m_fallback.clear();
+}
+
+bool utils::mapped_file::map(const std::string& filename)
+{
+#if MAPPED_FILE_WIN32
+	const HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	LARGE_INTEGER file_size{};
+	// Empty files can't be mapped, so let those take the buffered path.
+	if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+	const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	// The mapping keeps its own reference to the file.
+	CloseHandle(file);
+	if (mapping == nullptr)
+	{
+		return false;
+	}
+	const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (data == nullptr)
+	{
+		CloseHandle(mapping);
+		return false;
+	}
+	m_mapping = mapping;
+	m_data = static_cast<const char*>(data);
+	m_size = static_cast<std::size_t>(file_size.QuadPart);
+	return true;
+#elif MAPPED_FILE_POSIX
+	const int fd = open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+	struct stat file_stat{};
+	if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0)
+	{
+		close(fd);
+		return false;
+	}
+	const std::size_t size = static_cast<std::size_t>(file_stat.st_size);
+	void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping stays valid after the descriptor is closed.
+	close(fd);
+	if (data == MAP_FAILED)
+	{
+		return false;
+	}
+	m_mapping = data;
+	m_data = static_cast<const char*>(data);
+	m_size = size;
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool utils::mapped_file::read(const std::string& filename)
+{
+	std::ifstream file{ filename, std::ios::binary };
+	if (!file.is_open())
+	{
+		return false;
+	}
+	std::ostringstream contents;
+	contents << file.rdbuf();
+	m_fallback = std::move(contents).str();
+	m_data = m_fallback.data();
+	m_size = m_fallback.size();
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,228 @@
+#include "../utils/thread_pool.h"
+
+#include <utility>
+
+#include "../advent/advent_assert.h"
+
+namespace
+{
+	std::atomic<std::size_t> requested_thread_count{ 0 };
+	std::atomic<bool> global_pool_created{ false };
+
+	// Which pool, if any, the current thread works for, and its index there.
+	thread_local const utils::thread_pool* current_pool = nullptr;
+	thread_local std::size_t current_worker_id = 0;
+}
+
+void utils::set_thread_count(std::size_t num_threads)
+{
+	AdventCheckMsg(!global_pool_created, "The thread count can't change once the global thread pool is in use");
+	requested_thread_count = std::max<std::size_t>(num_threads, 1);
+}
+
+std::size_t utils::get_thread_count()
+{
+	const std::size_t requested = requested_thread_count;
+	if (requested != 0)
+	{
+		return requested;
+	}
+	return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+utils::thread_pool::thread_pool(std::size_t num_workers)
+{
+	m_worker_queues.reserve(num_workers);
+	for (std::size_t i = 0; i < num_workers; ++i)
+	{
+		m_worker_queues.push_back(std::make_unique<task_queue>());
+	}
+	m_workers.reserve(num_workers);
+	for (std::size_t i = 0; i < num_workers; ++i)
+	{
+		m_workers.emplace_back([this, i]() { worker_loop(i); });
+	}
+}
+
+utils::thread_pool::~thread_pool()
+{
+	{
+		std::lock_guard guard{ m_sleep_lock };
+		m_stopping = true;
+	}
+	m_wake.notify_all();
+	for (std::thread& worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+void utils::thread_pool::submit(task new_task)
+{
+	if (m_workers.empty())
+	{
+		new_task();
+		return;
+	}
+
+	task_queue& queue = current_pool == this ? *m_worker_queues[current_worker_id] : m_shared_queue;
+	{
+		std::lock_guard guard{ queue.lock };
+		queue.tasks.push_back(std::move(new_task));
+	}
+	++m_num_queued;
+	{
+		// Taking the lock means a worker can't miss this between checking for work and sleeping.
+		std::lock_guard guard{ m_sleep_lock };
+	}
+	m_wake.notify_one();
+}
+
+std::optional<utils::thread_pool::task> utils::thread_pool::take_task(std::size_t worker_id)
+{
+	auto take = [this](task_queue& queue, bool from_back) -> std::optional<task>
+	{
+		std::lock_guard guard{ queue.lock };
+		if (queue.tasks.empty())
+		{
+			return std::nullopt;
+		}
+		task result = from_back ? std::move(queue.tasks.back()) : std::move(queue.tasks.front());
+		from_back ? queue.tasks.pop_back() : queue.tasks.pop_front();
+		--m_num_queued;
+		return result;
+	};
+
+	if (auto own = take(*m_worker_queues[worker_id], true))
+	{
+		return own;
+	}
+	if (auto shared = take(m_shared_queue, false))
+	{
+		return shared;
+	}
+	const std::size_t num_queues = m_worker_queues.size();
+	for (std::size_t i = 1; i < num_queues; ++i)
+	{
+		if (auto stolen = take(*m_worker_queues[(worker_id + i) % num_queues], false))
+		{
+			return stolen;
+		}
+	}
+	return std::nullopt;
+}
+
+void utils::thread_pool::worker_loop(std::size_t worker_id)
+{
+	current_pool = this;
+	current_worker_id = worker_id;
+	while (true)
+	{
+		if (std::optional<task> next = take_task(worker_id))
+		{
+			next.value()();
+			continue;
+		}
+
+		std::unique_lock guard{ m_sleep_lock };
+		m_wake.wait(guard, [this]() { return m_stopping || m_num_queued > 0; });
+		if (m_stopping && m_num_queued == 0)
+		{
+			return;
+		}
+	}
+}
+
+utils::thread_pool& utils::thread_pool::global()
+{
+	// Built once, on first use, so callers never need a lock to reach it.
+	static thread_pool pool{ []()
+		{
+			global_pool_created = true;
+			return get_thread_count() - 1;
+		}() };
+	return pool;
+}
+
+bool utils::task_group::shared_state::run_one()
+{
+	std::function<void()> next;
+	{
+		std::lock_guard guard{ lock };
+		if (pending.empty())
+		{
+			return false;
+		}
+		next = std::move(pending.front());
+		pending.pop_front();
+		++num_running;
+	}
+
+	try
+	{
+		next();
+	}
+	catch (...)
+	{
+		std::lock_guard guard{ lock };
+		if (error == nullptr)
+		{
+			error = std::current_exception();
+		}
+	}
+
+	std::lock_guard guard{ lock };
+	--num_running;
+	if (pending.empty() && num_running == 0)
+	{
+		finished.notify_all();
+	}
+	return true;
+}
+
+utils::task_group::task_group(thread_pool& pool)
+	: m_pool{ pool }
+	, m_state{ std::make_shared<shared_state>() }
+{
+}
+
+utils::task_group::~task_group()
+{
+	try
+	{
+		wait();
+	}
+	catch (...)
+	{
+	}
+}
+
+void utils::task_group::run(std::function<void()> new_task)
+{
+	{
+		std::lock_guard guard{ m_state->lock };
+		m_state->pending.push_back(std::move(new_task));
+	}
+
+	// The pool only gets a ticket to run whichever of the group's tasks is next, so a task the
+	// waiting thread has already run leaves its ticket with nothing to do. With no workers,
+	// wait() runs everything.
+	if (m_pool.num_workers() > 0)
+	{
+		m_pool.submit([state = m_state]() { state->run_one(); });
+	}
+}
+
+void utils::task_group::wait()
+{
+	while (m_state->run_one())
+	{
+	}
+
+	std::unique_lock guard{ m_state->lock };
+	m_state->finished.wait(guard, [this]() { return m_state->pending.empty() && m_state->num_running == 0; });
+	if (m_state->error != nullptr)
+	{
+		std::rethrow_exception(std::exchange(m_state->error, nullptr));
+	}
+}
\ No newline at end of file
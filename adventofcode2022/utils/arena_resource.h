@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace utils
+{
+	// Hands out memory by bumping a pointer through a few large blocks, and never frees anything
+	// on its own: deallocate does nothing. Memory comes back all at once, either to a checkpoint
+	// taken earlier (rewind) or entirely (release). Blocks are kept after a rewind, so a search that
+	// is run again and again reuses the same memory rather than going back to the heap.
+	// Not thread safe; each thread has its own scratch_arena().
+	class arena_resource : public std::pmr::memory_resource
+	{
+	public:
+		struct checkpoint
+		{
+			std::size_t block = 0;
+			std::size_t offset = 0;
+		};
+
+		explicit arena_resource(std::size_t initial_block_size = 64 * 1024,
+			std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept;
+		arena_resource(const arena_resource&) = delete;
+		arena_resource& operator=(const arena_resource&) = delete;
+		~arena_resource() override { release(); }
+
+		checkpoint mark() const noexcept { return checkpoint{ m_current_block, m_offset }; }
+
+		// Everything allocated since mark() returned this checkpoint is gone afterwards.
+		// Fails the test if the checkpoint is ahead of the arena, such as one from before a release().
+		void rewind(checkpoint to);
+
+		// Gives every block back to the upstream resource.
+		void release() noexcept;
+
+		// Bytes between the start of the arena and the next allocation, including any padding and
+		// the unused ends of earlier blocks.
+		std::size_t bytes_used() const noexcept;
+		std::size_t bytes_reserved() const noexcept;
+
+	private:
+		struct block
+		{
+			std::byte* memory;
+			std::size_t size;
+			std::size_t alignment;
+		};
+
+		std::pmr::memory_resource* m_upstream;
+		std::size_t m_initial_block_size;
+		std::vector<block> m_blocks;
+		std::size_t m_current_block = 0;
+		std::size_t m_offset = 0;
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void*, std::size_t, std::size_t) override {}
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	};
+
+	// This thread's arena for memory that only lives as long as one piece of work.
+	// Take it through a scratch_scope, so it is rewound once the work is done.
+	arena_resource& scratch_arena() noexcept;
+
+	// Scratch memory for one function: containers that use resource() or allocator() get their
+	// memory from this thread's scratch_arena(), and all of it is handed back when the scope ends.
+	// Declare the scope before the containers, so they are destroyed first.
+	class scratch_scope
+	{
+		arena_resource& m_arena;
+		arena_resource::checkpoint m_start;
+	public:
+		scratch_scope() noexcept : m_arena{ scratch_arena() }, m_start{ m_arena.mark() } {}
+		scratch_scope(const scratch_scope&) = delete;
+		scratch_scope& operator=(const scratch_scope&) = delete;
+		// Scopes ended out of order fail the running test rather than terminating.
+		~scratch_scope() noexcept(false) { m_arena.rewind(m_start); }
+
+		std::pmr::memory_resource* resource() const noexcept { return &m_arena; }
+
+		template <typename T>
+		std::pmr::polymorphic_allocator<T> allocator() const noexcept { return std::pmr::polymorphic_allocator<T>{ &m_arena }; }
+	};
+}
\ No newline at end of file
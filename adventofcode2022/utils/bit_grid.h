@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "coords.h"
+#include "grid.h"
+
+namespace utils
+{
+	// A grid of on/off cells stored one bit per cell, so whole rows can be combined, shifted and
+	// counted 64 cells at a time. Each row starts on a new word, and bits past the end of a row
+	// are always zero, so a row's words can be used directly.
+	// Bit x % 64 of word x / 64 in a row is the cell at x.
+	class bit_grid
+	{
+	public:
+		using word_type = std::uint64_t;
+		static constexpr int bits_per_word = 64;
+	private:
+		std::vector<word_type> m_words;
+		utils::coords m_size;
+		std::size_t m_words_per_row = 0;
+
+		word_type last_word_mask() const noexcept;
+		void clear_padding() noexcept;
+		bool check_same_size(const bit_grid& other) const noexcept { return m_size == other.m_size; }
+	public:
+		bit_grid() = default;
+		explicit bit_grid(utils::coords size, bool initial_value = false);
+		explicit bit_grid(const grid<bool>& source);
+
+		grid<bool> to_grid() const;
+
+		utils::coords size() const noexcept { return m_size; }
+		std::size_t words_per_row() const noexcept { return m_words_per_row; }
+		bool is_on_grid(utils::coords coords) const noexcept;
+
+		bool get(utils::coords coords) const;
+		void set(utils::coords coords, bool value = true);
+		void reset(utils::coords coords) { set(coords, false); }
+		void fill(bool value);
+
+		// Setting bits past the end of the row is not allowed.
+		std::span<word_type> row(int y);
+		std::span<const word_type> row(int y) const;
+
+		// Up to 64 cells of row y from x onwards, with the cell at x in bit 0.
+		// Cells off the grid, on either side, read as off.
+		word_type get_bits(int x, int y, int count) const;
+
+		// The 3x3 block around centre, with the cell at centre + (dx,dy) in bit (dy+1)*3 + (dx+1).
+		// Cells off the grid read as off.
+		std::uint16_t neighbour_mask(utils::coords centre) const;
+
+		std::size_t count() const noexcept;
+		std::size_t count_row(int y) const;
+		bool any() const noexcept;
+
+		// These combine with a grid of the same size.
+		bit_grid& operator&=(const bit_grid& other);
+		bit_grid& operator|=(const bit_grid& other);
+		bit_grid& operator^=(const bit_grid& other);
+		bit_grid& and_not(const bit_grid& other);
+
+		// Moves every cell by offset. Cells moved off the grid are dropped, and cells moved in are off.
+		bit_grid shifted(utils::coords offset) const;
+
+		bool operator==(const bit_grid& other) const noexcept = default;
+	};
+
+	inline bit_grid operator&(bit_grid left, const bit_grid& right) { return left &= right; }
+	inline bit_grid operator|(bit_grid left, const bit_grid& right) { return left |= right; }
+	inline bit_grid operator^(bit_grid left, const bit_grid& right) { return left ^= right; }
+}
+
+inline utils::bit_grid::bit_grid(const grid<bool>& source)
+	: bit_grid(source.size())
+{
+	for (int y = 0; y < m_size.y; ++y)
+	{
+		const std::span<const bool> source_row = source.row(y);
+		const std::span<word_type> words = row(y);
+		for (std::size_t x = 0; x < source_row.size(); ++x)
+		{
+			words[x / bits_per_word] |= word_type{ source_row[x] } << (x % bits_per_word);
+		}
+	}
+}
+
+inline utils::grid<bool> utils::bit_grid::to_grid() const
+{
+	grid<bool> result{ m_size, false };
+	for (int y = 0; y < m_size.y; ++y)
+	{
+		const std::span<bool> result_row = result.row(y);
+		const std::span<const word_type> words = row(y);
+		for (std::size_t x = 0; x < result_row.size(); ++x)
+		{
+			result_row[x] = ((words[x / bits_per_word] >> (x % bits_per_word)) & 1) != 0;
+		}
+	}
+	return result;
+}
\ No newline at end of file
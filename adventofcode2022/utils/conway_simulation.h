@@ -1,11 +1,11 @@
 #pragma once
 
 #include <map>
+#include <cmath>
 #include <algorithm>
 #include <vector>
 #include <iterator>
 #include <array>
-#include <execution>
 #include <shared_mutex>
 #include <mutex>
 
@@ -14,6 +14,7 @@
 #include "range_contains.h"
 #include "erase_remove_if.h"
 #include "shared_lock_guard.h"
+#include "thread_pool.h"
 
 namespace utils::conway_simulation
 {
@@ -21,6 +22,9 @@ namespace utils::conway_simulation
 	// UpdateCellFunc: a function with the signature: bool(const CoordType& coord, bool is_on, std::size_t number_of_on_neighbours)
 	// GatherNeighboursFunc: a function with the signature std::vector<CoordType>(const CoordType&)
 	//							Results are cached and assumed to not change tick-to-tick.
+	// tick() spreads cells over the thread pool, so both functions are called from several threads
+	// at once and must be safe for that: pure functions of their arguments are. Set the thread count
+	// to one (utils::set_thread_count) to run a simulation whose functions aren't.
 	template <typename CoordType, typename UpdateCellFunc, typename GatherNeighboursFunc>
 	class state
 	{
@@ -80,10 +84,10 @@ namespace utils::conway_simulation
 		{
 			if (is_on)
 			{
-				return range_contains(num_neighbours_on, turn_off_range.first, turn_off_range.second);
+				return range_contains_inc(num_neighbours_on, turn_off_range.first, turn_off_range.second);
 			}
 			// else
-			return range_contains(num_neighbours_on, turn_on_range.first, turn_on_range.second);
+			return range_contains_inc(num_neighbours_on, turn_on_range.first, turn_on_range.second);
 		};
 	}
 
@@ -145,7 +149,7 @@ namespace utils::conway_simulation
 			{
 				for (std::size_t i = 0; i < c.size(); ++i)
 				{
-					if (!range_contains(c[i], 0, static_cast<int>(limits[i]-1)))
+					if (!range_contains_inc(c[i], 0, static_cast<int>(limits[i]-1)))
 					{
 						return true;
 					}
@@ -192,30 +196,45 @@ namespace utils::conway_simulation
 		m_next_cells.clear();
 		m_relevant_cells.clear();
 
-		// Gather all relevant cells
+		// Lookups from other threads must not trigger a lazy sort.
+		m_on_cells.sort();
+
+		// Gather all relevant cells. Each chunk of cells gathers into its own list, so the shared
+		// list is only locked once per chunk.
 		std::mutex relevant_cells_lock;
-		auto gather_relevant = [this,&relevant_cells_lock](const CoordType& on_cell)
+		utils::parallel_for_ranges(std::size_t{ 0 }, m_on_cells.size(), [this, &relevant_cells_lock](std::size_t first, std::size_t last)
 		{
-			const auto& neighbours = get_neighbours(on_cell);
+			std::vector<CoordType> gathered;
+			for (std::size_t i = first; i < last; ++i)
+			{
+				const CoordType& on_cell = m_on_cells.begin()[i];
+				const auto& neighbours = get_neighbours(on_cell);
+				gathered.push_back(on_cell);
+				std::copy(begin(neighbours), end(neighbours), std::back_inserter(gathered));
+			}
 			std::lock_guard<std::mutex> relevant_cells_guard{ relevant_cells_lock };
-			m_relevant_cells.reserve((neighbours.size() + 1) * m_on_cells.size());
-			m_relevant_cells.push_back(on_cell);
-			std::copy(begin(neighbours), end(neighbours), std::back_inserter(m_relevant_cells));
-		};
-		std::for_each(std::execution::unseq, begin(m_on_cells), end(m_on_cells), gather_relevant);
+			std::copy(begin(gathered), end(gathered), std::back_inserter(m_relevant_cells));
+		});
 
 		m_relevant_cells.unique();
 
-		std::copy_if(begin(m_relevant_cells), end(m_relevant_cells), std::back_inserter(m_next_cells),
-			[this](const CoordType& cell)
+		std::mutex next_cells_lock;
+		utils::parallel_for_ranges(std::size_t{ 0 }, m_relevant_cells.size(), [this, &next_cells_lock](std::size_t first, std::size_t last)
 		{
-			const auto& neighbours = get_neighbours(cell);
-			const std::size_t num_neighbours_on = std::count_if(begin(neighbours), end(neighbours),
-				[this](const CoordType& neighbour)
+			std::vector<CoordType> next_cells;
+			std::copy_if(m_relevant_cells.begin() + first, m_relevant_cells.begin() + last, std::back_inserter(next_cells),
+				[this](const CoordType& cell)
 			{
-				return is_cell_on(neighbour);
+				const auto& neighbours = get_neighbours(cell);
+				const std::size_t num_neighbours_on = std::count_if(begin(neighbours), end(neighbours),
+					[this](const CoordType& neighbour)
+				{
+					return is_cell_on(neighbour);
+				});
+				return m_update_cell(cell, is_cell_on(cell), num_neighbours_on);
 			});
-			return m_update_cell(cell, is_cell_on(cell), num_neighbours_on);
+			std::lock_guard<std::mutex> next_cells_guard{ next_cells_lock };
+			std::copy(begin(next_cells), end(next_cells), std::back_inserter(m_next_cells));
 		});
 
 		m_on_cells.swap(m_next_cells);
@@ -235,11 +254,11 @@ namespace utils::conway_simulation
 			}
 		}
 
-		// Otherwise gather neighbours and cache the result.
+		// Otherwise gather neighbours and cache the result. Another thread may have cached the same
+		// cell meanwhile, in which case its result is kept, as both are the same.
 		auto neighbours = std::make_pair(coords, m_gather_neighbours(coords));
 		std::lock_guard guard{ m_cached_neighbours_lock };
 		const auto insert_it = m_cached_neighbours.insert(std::move(neighbours));
-		AdventCheck(insert_it.second);
 		return insert_it.first->second;
 	}
 }
\ No newline at end of file
@@ -4,6 +4,13 @@
 #include <type_traits>
 #include <optional>
 #include <algorithm>
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <array>
+#include <span>
+#include <cstring>
+#include <bit>
 
 #include "../advent/advent_assert.h"
 #include "istream_line_iterator.h"
@@ -30,7 +37,16 @@ namespace utils
 		utils::small_vector<NodeType,1> m_nodes;
 		utils::coords max_point;
 		std::size_t get_idx(int x, int y) const;
+		utils::coords get_coords(std::size_t idx) const;
+
+		// The index of the first node equal to node at or after first, or m_nodes.size().
+		std::size_t find_node(const NodeType& node, std::size_t first) const;
 	public:
+		grid() = default;
+		grid(utils::coords size, const NodeType& initial_value);
+
+		utils::coords size() const { return max_point; }
+
 		bool is_on_grid(int x, int y) const;
 		bool is_on_grid(utils::coords coords) const { return is_on_grid(coords.x,coords.y); }
 
@@ -39,48 +55,91 @@ namespace utils
 		NodeType& at(utils::coords coords) { return at(coords.x,coords.y); }
 		const NodeType& at(utils::coords coords) const { return at(coords.x,coords.y); }
 
-		// Get all nodes that meet a predicate
+		// Rows are contiguous in memory, so row-by-row is the fast way through the grid.
+		std::span<NodeType> row(int y) { return std::span<NodeType>{ m_nodes.data() + get_idx(0, y), static_cast<std::size_t>(max_point.x) }; }
+		std::span<const NodeType> row(int y) const { return std::span<const NodeType>{ m_nodes.data() + get_idx(0, y), static_cast<std::size_t>(max_point.x) }; }
+
+		// Calls func(y, row(y)) for each row, top to bottom.
+		void for_each_row(const auto& func)
+		{
+			for (int y = 0; y < max_point.y; ++y)
+			{
+				func(y, row(y));
+			}
+		}
+
+		void for_each_row(const auto& func) const
+		{
+			for (int y = 0; y < max_point.y; ++y)
+			{
+				func(y, row(y));
+			}
+		}
+
+		// Calls func(coords, node) for each cell, in the order they are stored.
+		void for_each_cell(const auto& func)
+		{
+			for_each_row([&func](int y, std::span<NodeType> nodes)
+				{
+					for (int x = 0; x < static_cast<int>(nodes.size()); ++x)
+					{
+						func(utils::coords{ x,y }, nodes[static_cast<std::size_t>(x)]);
+					}
+				});
+		}
+
+		void for_each_cell(const auto& func) const
+		{
+			for_each_row([&func](int y, std::span<const NodeType> nodes)
+				{
+					for (int x = 0; x < static_cast<int>(nodes.size()); ++x)
+					{
+						func(utils::coords{ x,y }, nodes[static_cast<std::size_t>(x)]);
+					}
+				});
+		}
+
+		// Get all nodes that meet a predicate, in row order.
 		utils::small_vector<coords,1> get_all_coordinates_by_predicate(auto predicate) const
 		{
 			utils::small_vector<coords, 1> result;
-			for (int x : utils::int_range{ max_point.x })
-			{
-				for (int y : utils::int_range{ max_point.y })
+			for_each_cell([&predicate, &result](const utils::coords& coords, const NodeType& elem)
 				{
-					const NodeType& elem = at(x, y);
 					if (predicate(elem))
 					{
-						result.push_back(utils::coords{ x,y });
+						result.push_back(coords);
 					}
-				}
-			}
+				});
 			return result;
 		}
 
-		// Get a node using a predicate
+		// Get the first node in row order that meets a predicate
 		std::optional<utils::coords> get_coordinates_by_predicate(auto predicate) const
 		{
-			for (int x : utils::int_range{max_point.x})
+			const auto find_result = std::find_if(m_nodes.begin(), m_nodes.end(), predicate);
+			if (find_result == m_nodes.end())
 			{
-				for(int y : utils::int_range{max_point.y})
-				{
-					const NodeType& elem = at(x,y);
-					if (predicate(elem))
-					{
-						return utils::coords{x,y};
-					}
-				}
+				return std::nullopt;
 			}
-			return std::nullopt;
+			return get_coords(static_cast<std::size_t>(find_result - m_nodes.begin()));
 		}
 
 		// Get a node using NodeType::operator==
 		std::optional<utils::coords> get_coordinates(const NodeType& node) const
 		{
-			return get_coordinates_by_predicate([&node](const NodeType& other)
+			const std::size_t idx = find_node(node, 0);
+			return idx < m_nodes.size() ? std::optional{ get_coords(idx) } : std::nullopt;
+		}
+
+		// Get all nodes equal to node, in row order
+		utils::small_vector<coords,1> get_all_coordinates(const NodeType& node) const
+		{
+			utils::small_vector<coords, 1> result;
+			for (std::size_t idx = find_node(node, 0); idx < m_nodes.size(); idx = find_node(node, idx + 1))
 			{
-				return node == other;
-			});
+				result.push_back(get_coords(idx));
+			}
+			return result;
 		}
 
 		void build_from_stream(std::istream& iss, const auto& char_to_node_fn)
@@ -118,10 +177,67 @@ namespace utils
 			const auto& cost_or_heuristic_fn) const;
 
 		utils::small_vector<utils::coords,1> get_path(const utils::coords& start, const utils::coords& end) const;
+
+		// The distance from the nearest of sources to every cell, in one search, moving between
+		// neighbouring cells (diagonals included) that cost_fn allows. cost_fn is either a step
+		// function [bool(utils::coords,NodeType,utils::coords,NodeType)], where every allowed step
+		// costs 1 and the result is a grid<int>, or a cost function like get_path's, giving a
+		// grid<float>. Cells that can't be reached hold std::numeric_limits<DistanceType>::max().
+		auto distance_field(const auto& sources, const auto& cost_fn) const;
+	};
+
+	// A grid stored with a one cell border all the way round it, filled with a wall value. Every
+	// cell on the grid then has all eight neighbours in memory at fixed offsets from its index
+	// (see neighbour_offsets), so loops over neighbours need no bounds checks: as long as the
+	// wall value stops the loop, nothing ever steps off the border.
+	// Indices count the border too, so (-1,-1) is index 0 and (0,0) is index stride() + 1.
+	template <typename NodeType>
+	class padded_grid
+	{
+		utils::small_vector<NodeType,1> m_nodes;
+		utils::coords m_size;
+		std::size_t m_stride = 0;
+	public:
+		padded_grid() = default;
+		padded_grid(utils::coords size, const NodeType& initial_value, const NodeType& wall);
+		padded_grid(const grid<NodeType>& source, const NodeType& wall);
+
+		// The size without the border.
+		utils::coords size() const { return m_size; }
+		std::size_t stride() const { return m_stride; }
+
+		bool is_on_grid(utils::coords coords) const;
+
+		// Accepts the border cells as well as the ones on the grid.
+		std::size_t get_idx(utils::coords coords) const;
+		utils::coords get_coords(std::size_t idx) const;
+
+		// Unchecked, for use with get_idx and neighbour_offsets.
+		NodeType& operator[](std::size_t idx) { return m_nodes.data()[idx]; }
+		const NodeType& operator[](std::size_t idx) const { return m_nodes.data()[idx]; }
+
+		NodeType& at(utils::coords coords) { AdventCheck(is_on_grid(coords)); return m_nodes[get_idx(coords)]; }
+		const NodeType& at(utils::coords coords) const { AdventCheck(is_on_grid(coords)); return m_nodes[get_idx(coords)]; }
+
+		// What to add to an index to reach each neighbour, in the order of grid_helpers::neighbour_offsets.
+		std::array<std::ptrdiff_t, 8> neighbour_offsets() const;
+
+		// The cells of row y on the grid, without the border.
+		std::span<NodeType> row(int y) { return std::span<NodeType>{ m_nodes.data() + get_idx(utils::coords{ 0,y }), static_cast<std::size_t>(m_size.x) }; }
+		std::span<const NodeType> row(int y) const { return std::span<const NodeType>{ m_nodes.data() + get_idx(utils::coords{ 0,y }), static_cast<std::size_t>(m_size.x) }; }
+
+		// A copy without the border.
+		grid<NodeType> unpadded() const;
 	};
 
 	namespace grid_helpers
 	{
+		// The eight cells around a cell, which searches offer to the cost function in this order.
+		constexpr std::array<utils::coords, 8> neighbour_offsets{
+			utils::coords{ -1,-1 }, utils::coords{ -1,0 }, utils::coords{ -1,1 },
+			utils::coords{ 0,-1 }, utils::coords{ 0,1 },
+			utils::coords{ 1,-1 }, utils::coords{ 1,0 }, utils::coords{ 1,1 } };
+
 		template <typename NodeType, typename FnType>
 		constexpr bool is_end_fn()
 		{
@@ -137,6 +253,17 @@ namespace utils
 				utils::coords, NodeType>;
 		}
 
+		template <typename NodeType, typename FnType>
+		constexpr bool is_step_fn()
+		{
+			// Checked exactly, as a bool would also convert to a cost.
+			if constexpr (std::is_invocable_v<FnType, utils::coords, NodeType, utils::coords, NodeType>)
+			{
+				return std::is_same_v<std::invoke_result_t<FnType, utils::coords, NodeType, utils::coords, NodeType>, bool>;
+			}
+			return false;
+		}
+
 		template <typename NodeType, typename FnType>
 		constexpr bool is_heuristic_fn()
 		{
@@ -204,6 +331,14 @@ namespace utils
 	}
 }
 
+template <typename NodeType>
+inline utils::grid<NodeType>::grid(utils::coords size, const NodeType& initial_value)
+	: m_nodes(static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y), initial_value)
+	, max_point{ size }
+{
+	AdventCheck(size.x >= 0 && size.y >= 0);
+}
+
 template <typename NodeType>
 inline bool utils::grid<NodeType>::is_on_grid(int x, int y) const
 {
@@ -222,6 +357,100 @@ inline std::size_t utils::grid<NodeType>::get_idx(int x, int y) const
 	return result;
 }
 
+template <typename NodeType>
+inline utils::coords utils::grid<NodeType>::get_coords(std::size_t idx) const
+{
+	AdventCheck(idx < m_nodes.size());
+	const std::size_t width = static_cast<std::size_t>(max_point.x);
+	return utils::coords{ static_cast<int>(idx % width), static_cast<int>(idx / width) };
+}
+
+template <typename NodeType>
+inline std::size_t utils::grid<NodeType>::find_node(const NodeType& node, std::size_t first) const
+{
+	AdventCheck(first <= m_nodes.size());
+	if (first == m_nodes.size())
+	{
+		return first;
+	}
+	// Byte-sized nodes that compare by value (char, bool, small enums) go through memchr, which
+	// the C library vectorises. Anything else is compared one node at a time.
+	if constexpr (sizeof(NodeType) == 1 && std::has_unique_object_representations_v<NodeType>)
+	{
+		const void* const found = std::memchr(m_nodes.data() + first, std::bit_cast<unsigned char>(node), m_nodes.size() - first);
+		return found != nullptr ? static_cast<std::size_t>(static_cast<const NodeType*>(found) - m_nodes.data()) : m_nodes.size();
+	}
+	else
+	{
+		return static_cast<std::size_t>(std::find(m_nodes.begin() + first, m_nodes.end(), node) - m_nodes.begin());
+	}
+}
+
+template <typename NodeType>
+inline utils::padded_grid<NodeType>::padded_grid(utils::coords size, const NodeType& initial_value, const NodeType& wall)
+	: m_nodes((static_cast<std::size_t>(size.x) + 2) * (static_cast<std::size_t>(size.y) + 2), wall)
+	, m_size{ size }
+	, m_stride{ static_cast<std::size_t>(size.x) + 2 }
+{
+	AdventCheck(size.x >= 0 && size.y >= 0);
+	for (int y = 0; y < m_size.y; ++y)
+	{
+		std::ranges::fill(row(y), initial_value);
+	}
+}
+
+template <typename NodeType>
+inline utils::padded_grid<NodeType>::padded_grid(const grid<NodeType>& source, const NodeType& wall)
+	: padded_grid(source.size(), wall, wall)
+{
+	for (int y = 0; y < m_size.y; ++y)
+	{
+		std::ranges::copy(source.row(y), row(y).begin());
+	}
+}
+
+template <typename NodeType>
+inline bool utils::padded_grid<NodeType>::is_on_grid(utils::coords coords) const
+{
+	return coords.x >= 0 && coords.y >= 0 && coords.x < m_size.x && coords.y < m_size.y;
+}
+
+template <typename NodeType>
+inline std::size_t utils::padded_grid<NodeType>::get_idx(utils::coords coords) const
+{
+	AdventCheck(coords.x >= -1 && coords.y >= -1 && coords.x <= m_size.x && coords.y <= m_size.y);
+	return static_cast<std::size_t>(coords.y + 1) * m_stride + static_cast<std::size_t>(coords.x + 1);
+}
+
+template <typename NodeType>
+inline utils::coords utils::padded_grid<NodeType>::get_coords(std::size_t idx) const
+{
+	AdventCheck(idx < m_nodes.size());
+	return utils::coords{ static_cast<int>(idx % m_stride) - 1, static_cast<int>(idx / m_stride) - 1 };
+}
+
+template <typename NodeType>
+inline std::array<std::ptrdiff_t, 8> utils::padded_grid<NodeType>::neighbour_offsets() const
+{
+	std::array<std::ptrdiff_t, 8> result;
+	std::ranges::transform(utils::grid_helpers::neighbour_offsets, begin(result), [this](const utils::coords& offset)
+		{
+			return static_cast<std::ptrdiff_t>(offset.y) * static_cast<std::ptrdiff_t>(m_stride) + offset.x;
+		});
+	return result;
+}
+
+template <typename NodeType>
+inline utils::grid<NodeType> utils::padded_grid<NodeType>::unpadded() const
+{
+	grid<NodeType> result{ m_size, NodeType{} };
+	for (int y = 0; y < m_size.y; ++y)
+	{
+		std::ranges::copy(row(y), result.row(y).begin());
+	}
+	return result;
+}
+
 template<typename NodeType>
 inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(const utils::coords& start, const auto& is_end_fn, const auto& traverse_cost_fn, const auto& heuristic_fn) const
 {
@@ -235,10 +464,17 @@ inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(cons
 
 	utils::small_vector<utils::coords,1> result;
 
+	// What is known about each cell. Everything is indexed like a padded_grid, with the border
+	// marked as searched, so neighbours are reached by offset and never checked against the edges.
+	struct CellState
+	{
+		float best_cost = std::numeric_limits<float>::infinity();
+		int previous_cell = -1;
+	};
+
 	struct SearchNode
 	{
-		int previous_node_id = -1;
-		utils::coords position;
+		int cell = -1;
 		float cost = 0.0f;
 		float cost_and_heuristic = 0.0f;
 	};
@@ -248,39 +484,33 @@ inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(cons
 		return left.cost_and_heuristic > right.cost_and_heuristic;
 	};
 
-	utils::small_vector<SearchNode,1> searched_nodes;
-	utils::small_vector<SearchNode,1> unsearched_nodes;
+	// The border is never offered to the cost function, so any node will do as its wall.
+	const utils::padded_grid<NodeType> nodes{ *this, m_nodes.front() };
+	utils::padded_grid<CellState> cells{ max_point, CellState{}, CellState{} };
+	utils::padded_grid<bool> searched{ max_point, false, true };
+	const std::array<std::ptrdiff_t, 8> offsets = nodes.neighbour_offsets();
 
-	auto try_add_node = [this,&unsearched_nodes,&searched_nodes, &traverse_cost_fn, &heuristic_fn]
-		(int previous_node_id, const SearchNode& from, utils::coords to)
+	// A binary heap with the cheapest node on top. A cell is pushed again whenever a cheaper way
+	// to it is found, rather than being moved within the heap; whichever copy comes off the top
+	// first is the cheapest, and the rest are skipped once the cell is searched.
+	std::vector<SearchNode> unsearched_nodes;
+
+	auto try_add_node = [&nodes,&cells,&searched,&unsearched_nodes,&traverse_cost_fn,&heuristic_fn,&order_on_heuristic]
+		(int previous_cell, const utils::coords& from, float cost, std::size_t to_idx, const utils::coords& to)
 	{
-		if (!is_on_grid(to))
-		{
-#if AOC_GRID_DEBUG
-			std::cout << "    Skip adding node at " << to << ": Not on grid.\n";
-#endif
-			return;
-		}
-		const auto has_checked_result = std::find_if(begin(searched_nodes), end(searched_nodes), [this,&to](const SearchNode& node)
-			{
-				return node.position == to;
-			});
-		if (has_checked_result != end(searched_nodes))
+		if (searched[to_idx])
 		{
 #if AOC_GRID_DEBUG
-			std::cout << "    Skip adding node at " << to << ": Already checked.\n";
+			std::cout << "    Skip adding node at " << to << ": Already checked or not on grid.\n";
 #endif
 			return;
 		}
-		SearchNode result;
-		result.previous_node_id = previous_node_id;
-		result.position = to;
 
-		const NodeType& to_node(at(to));
-		if (previous_node_id >= 0)
+		const NodeType& to_node = nodes[to_idx];
+		if (previous_cell >= 0)
 		{
-			const NodeType& from_node = at(from.position);
-			const std::optional<float> latest_cost_opt = traverse_cost_fn(from.position, from_node, to, to_node);
+			const std::size_t from_idx = static_cast<std::size_t>(previous_cell);
+			const std::optional<float> latest_cost_opt = traverse_cost_fn(from, nodes[from_idx], to, to_node);
 			if (!latest_cost_opt.has_value())
 			{
 #if AOC_GRID_DEBUG
@@ -288,93 +518,74 @@ inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(cons
 #endif
 				return;
 			}
-			const float latest_cost = *latest_cost_opt;
-			result.cost = from.cost + latest_cost;
+			cost += *latest_cost_opt;
 		}
-		else
+
+		CellState& state = cells[to_idx];
+		if (!(cost < state.best_cost))
 		{
-			result.cost = 0.0f;
+#if AOC_GRID_DEBUG
+			std::cout << "    Skip adding node at " << to << ": Already reachable as cheaply.\n";
+#endif
+			return;
 		}
+		state.best_cost = cost;
+		state.previous_cell = previous_cell;
+
 		const float heuristic = heuristic_fn(to, to_node);
-		result.cost_and_heuristic = result.cost + heuristic;
 #if AOC_GRID_DEBUG
 		std::cout << "    Adding node to search: Loc="
-			<< result.position << " C=" << result.cost << " H=" << result.cost_and_heuristic << '\n';
+			<< to << " C=" << cost << " H=" << cost + heuristic << '\n';
 #endif
-		unsearched_nodes.push_back(result);
+		unsearched_nodes.push_back(SearchNode{ static_cast<int>(to_idx), cost, cost + heuristic });
+		std::push_heap(begin(unsearched_nodes), end(unsearched_nodes), order_on_heuristic);
 	};
 
-	{
-		SearchNode first_node;
-		first_node.position = start;
-		try_add_node(-1, SearchNode{}, start);
-	}
+	try_add_node(-1, start, 0.0f, nodes.get_idx(start), start);
 
 	while (!unsearched_nodes.empty())
 	{
 #if AOC_GRID_DEBUG
-		std::cout << "Searched nodes: " << searched_nodes.size() << " Unsearched nodes: " << unsearched_nodes.size() << '\n';
+		std::cout << "Unsearched nodes: " << unsearched_nodes.size() << '\n';
 #endif
+		std::pop_heap(begin(unsearched_nodes), end(unsearched_nodes), order_on_heuristic);
 		const SearchNode next_node = unsearched_nodes.back();
-#if AOC_GRID_DEBUG
-		std::cout << "Expanding node: " << next_node.position << " with cost=" << next_node.cost
-			<< " heuristic=" << next_node.cost_and_heuristic << '\n';
-#endif
 		unsearched_nodes.pop_back();
 
+		const std::size_t next_idx = static_cast<std::size_t>(next_node.cell);
+		if (searched[next_idx])
 		{
-			const auto already_checked_result = std::find_if(begin(searched_nodes), end(searched_nodes),
-				[&next_node](const SearchNode& previous_node)
-				{
-					return next_node.position == previous_node.position;
-				});
-			if (already_checked_result != end(searched_nodes))
-			{
 #if AOC_GRID_DEBUG
-				std::cout << "    Skipping node " << next_node.position << ": already searched here.\n";
+			std::cout << "    Skipping node " << nodes.get_coords(next_idx) << ": already searched here.\n";
 #endif
-				continue;
-			}
+			continue;
 		}
+		searched[next_idx] = true;
+
+		const utils::coords next_position = nodes.get_coords(next_idx);
+#if AOC_GRID_DEBUG
+		std::cout << "Expanding node: " << next_position << " with cost=" << next_node.cost
+			<< " heuristic=" << next_node.cost_and_heuristic << '\n';
+#endif
 
-		const bool node_is_end = is_end_fn(next_node.position,at(next_node.position));
+		const bool node_is_end = is_end_fn(next_position, nodes[next_idx]);
 		if (node_is_end)
 		{
-			SearchNode path_node = next_node;
-			while(true)
+			for (int cell = next_node.cell; cell >= 0; cell = cells[static_cast<std::size_t>(cell)].previous_cell)
 			{
-				result.push_back(path_node.position);
-				if (path_node.previous_node_id < 0)
-				{
-					break;
-				}
-				else
-				{
-					const std::size_t previous_idx = static_cast<std::size_t>(path_node.previous_node_id);
-					AdventCheck(previous_idx < searched_nodes.size());
-					path_node = searched_nodes[previous_idx];
-				}
+				result.push_back(nodes.get_coords(static_cast<std::size_t>(cell)));
 			}
 #if AOC_GRID_DEBUG
-			std::cout << "Found target node: " << next_node.position << " Total path len=" << result.size() << '\n';
+			std::cout << "Found target node: " << next_position << " Total path len=" << result.size() << '\n';
 #endif
 			break;
 		}
 
-		const int previous_id = static_cast<int>(searched_nodes.size());
-		for (int dx : utils::int_range{ -1,2 })
+		for (std::size_t i = 0; i < offsets.size(); ++i)
 		{
-			for (int dy : utils::int_range{ -1,2 })
-			{
-				if (dx == 0 && dy == 0) continue;
-				const utils::coords delta_pos{ dx,dy };
-				const utils::coords next_coords = next_node.position + delta_pos;
-				try_add_node(previous_id, next_node, next_coords);
-			}
+			const std::size_t to_idx = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(next_idx) + offsets[i]);
+			try_add_node(next_node.cell, next_position, next_node.cost, to_idx, next_position + utils::grid_helpers::neighbour_offsets[i]);
 		}
-
-		std::sort(begin(unsearched_nodes), end(unsearched_nodes), order_on_heuristic);
-		searched_nodes.push_back(next_node);
 	}
 
 	return result;
@@ -393,7 +604,7 @@ inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(cons
 	}
 	if constexpr (is_heuristic_fn)
 	{
-		auto cost_fn = utils::grid_helpers::DefaultCostFunctor<false>{};
+		auto cost_fn = utils::grid_helpers::DefaultCostFunctor<NodeType,false>{};
 		return get_path(start, is_end_fn, cost_fn, cost_or_heuristic_fn);
 	}
 	AdventUnreachable();
@@ -403,7 +614,7 @@ inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(cons
 template<typename NodeType>
 inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(const utils::coords& start, const auto& is_end_fn) const
 {
-	return get_path(start, is_end_fn, utils::grid_helpers::DefaultCostFunctor<false>{}, utils::grid_helpers::DefaultHeuristicFunctor<NodeType>{});
+	return get_path(start, is_end_fn, utils::grid_helpers::DefaultCostFunctor<NodeType,false>{}, utils::grid_helpers::DefaultHeuristicFunctor<NodeType>{});
 }
 
 template<typename NodeType>
@@ -429,7 +640,7 @@ inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(cons
 	}
 	if constexpr (is_heuristic_fn)
 	{
-		auto cost_fn = utils::grid_helpers::DefaultCostFunctor<false>{};
+		auto cost_fn = utils::grid_helpers::DefaultCostFunctor<NodeType,false>{};
 		return get_path(start, end, cost_fn, cost_or_heuristic_fn);
 	}
 	AdventUnreachable();
@@ -439,5 +650,119 @@ inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(cons
 template<typename NodeType>
 inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(const utils::coords& start, const utils::coords& end) const
 {
-	return get_path(start, end, utils::grid_helpers::DefaultCostFunctor{}, utils::grid_helpers::DefaultHeuristicFunctor<NodeType>{ end });
+	return get_path(start, end, utils::grid_helpers::DefaultCostFunctor<NodeType,false>{}, utils::grid_helpers::DefaultHeuristicFunctor<NodeType>{ end });
 }
+
+
+template<typename NodeType>
+inline auto utils::grid<NodeType>::distance_field(const auto& sources, const auto& cost_fn) const
+{
+	constexpr bool is_step_fn = utils::grid_helpers::is_step_fn<NodeType, decltype(cost_fn)>();
+	constexpr bool is_cost_fn = utils::grid_helpers::is_cost_fn<NodeType, decltype(cost_fn)>();
+	static_assert(is_step_fn || is_cost_fn, "cost_fn must be a step [bool(utils::coords,NodeType,utils::coords,NodeType)] or a cost [std::optional<float>(utils::coords,NodeType,utils::coords,NodeType)] function");
+
+	using DistanceType = std::conditional_t<is_step_fn, int, float>;
+	constexpr DistanceType unreached = std::numeric_limits<DistanceType>::max();
+
+	// Worked out on padded grids, so neighbours are reached by offset with no bounds checks.
+	// The distances' border is below any real distance, which stops both searches at the edge,
+	// and as nothing crosses the border, any node will do as the nodes' wall.
+	if (m_nodes.empty())
+	{
+		return grid<DistanceType>{ max_point, unreached };
+	}
+	const utils::padded_grid<NodeType> nodes{ *this, m_nodes.front() };
+	utils::padded_grid<DistanceType> distances{ max_point, unreached, std::numeric_limits<DistanceType>::lowest() };
+	const std::array<std::ptrdiff_t, 8> offsets = nodes.neighbour_offsets();
+
+	auto get_source_idx = [this, &nodes](const utils::coords& source)
+	{
+		AdventCheck(is_on_grid(source));
+		return nodes.get_idx(source);
+	};
+
+	if constexpr (is_step_fn)
+	{
+		// Breadth first: with every step costing the same, cells leave a plain queue in order of
+		// distance. Each cell joins the queue once, so it never needs more room than there are
+		// cells, and never moves once reserved.
+		std::vector<std::size_t> queue;
+		queue.reserve(m_nodes.size());
+		for (const utils::coords& source : sources)
+		{
+			const std::size_t idx = get_source_idx(source);
+			if (distances[idx] == unreached)
+			{
+				distances[idx] = 0;
+				queue.push_back(idx);
+			}
+		}
+
+		for (std::size_t next = 0; next < queue.size(); ++next)
+		{
+			const std::size_t from_idx = queue[next];
+			const utils::coords from = nodes.get_coords(from_idx);
+			const int to_distance = distances[from_idx] + 1;
+			for (std::size_t i = 0; i < offsets.size(); ++i)
+			{
+				const std::size_t to_idx = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(from_idx) + offsets[i]);
+				if (distances[to_idx] != unreached) continue;
+				const utils::coords to = from + utils::grid_helpers::neighbour_offsets[i];
+				if (!cost_fn(from, nodes[from_idx], to, nodes[to_idx])) continue;
+				distances[to_idx] = to_distance;
+				queue.push_back(to_idx);
+			}
+		}
+	}
+	else
+	{
+		// Dijkstra, with the same lazily updated heap as get_path.
+		struct SearchNode
+		{
+			std::size_t cell;
+			float cost;
+		};
+		auto order_on_cost = [](const SearchNode& left, const SearchNode& right)
+		{
+			return left.cost > right.cost;
+		};
+		std::vector<SearchNode> unsearched_nodes;
+		utils::padded_grid<bool> searched{ max_point, false, true };
+
+		auto try_add_node = [&distances, &unsearched_nodes, &order_on_cost](std::size_t idx, float cost)
+		{
+			if (!(cost < distances[idx])) return;
+			distances[idx] = cost;
+			unsearched_nodes.push_back(SearchNode{ idx, cost });
+			std::push_heap(begin(unsearched_nodes), end(unsearched_nodes), order_on_cost);
+		};
+
+		for (const utils::coords& source : sources)
+		{
+			try_add_node(get_source_idx(source), 0.0f);
+		}
+
+		while (!unsearched_nodes.empty())
+		{
+			std::pop_heap(begin(unsearched_nodes), end(unsearched_nodes), order_on_cost);
+			const SearchNode next_node = unsearched_nodes.back();
+			unsearched_nodes.pop_back();
+			if (searched[next_node.cell]) continue;
+			searched[next_node.cell] = true;
+
+			const utils::coords from = nodes.get_coords(next_node.cell);
+			for (std::size_t i = 0; i < offsets.size(); ++i)
+			{
+				const std::size_t to_idx = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(next_node.cell) + offsets[i]);
+				if (searched[to_idx]) continue;
+				const utils::coords to = from + utils::grid_helpers::neighbour_offsets[i];
+				const std::optional<float> step_cost = cost_fn(from, nodes[next_node.cell], to, nodes[to_idx]);
+				if (step_cost.has_value())
+				{
+					try_add_node(to_idx, next_node.cost + *step_cost);
+				}
+			}
+		}
+	}
+	return distances.unpadded();
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace utils
+{
+	// A whole file exposed as one read-only view. Where the platform supports it the file
+	// is memory-mapped, so nothing is copied; elsewhere it is read into a buffer once.
+	// The view is valid for as long as the mapped_file is alive.
+	class mapped_file
+	{
+		const char* m_data = nullptr;
+		std::size_t m_size = 0;
+		void* m_mapping = nullptr;
+		std::string m_fallback;
+		void release() noexcept;
+		bool map(const std::string& filename);
+		bool read(const std::string& filename);
+	public:
+		mapped_file() noexcept = default;
+		// Throws advent::test_failed if the file can't be opened.
+		explicit mapped_file(const std::string& filename);
+		mapped_file(const mapped_file&) = delete;
+		mapped_file& operator=(const mapped_file&) = delete;
+		mapped_file(mapped_file&& other) noexcept;
+		mapped_file& operator=(mapped_file&& other) noexcept;
+		~mapped_file() noexcept { release(); }
+
+		std::string_view view() const noexcept { return std::string_view{ m_data, m_size }; }
+		bool is_mapped() const noexcept { return m_mapping != nullptr; }
+	};
+}
\ No newline at end of file
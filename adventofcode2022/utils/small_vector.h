@@ -7,9 +7,18 @@
 #include <compare>
 #include <algorithm>
 #include <cstring>
+#include <bit>
 
 #include "../advent/advent_assert.h"
 
+// Lets an empty allocator such as std::allocator take up no space. MSVC ignores the standard
+// attribute and needs its own spelling.
+#if defined(_MSC_VER)
+#define UTILS_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define UTILS_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
 namespace utils
 {
 	template <typename T, std::size_t STACK_SIZE, typename ALLOC = std::allocator<T>>
@@ -55,7 +64,7 @@ namespace utils
 		constexpr void assign(std::initializer_list<T> init);
 
 		// Allocator
-		constexpr allocator_type get_allocator() const noexcept { return allocator_type(); }
+		constexpr allocator_type get_allocator() const noexcept { return m_allocator; }
 
 		// Element access
 		constexpr reference at(size_type pos);
@@ -156,6 +165,13 @@ namespace utils
 		data_access m_data;
 		std::size_t m_num_elements;
 		std::size_t m_capacity;
+		UTILS_NO_UNIQUE_ADDRESS allocator_type m_allocator;
+
+		// Whether other's heap memory can become ours, and so be freed with our allocator.
+		constexpr bool can_take_heap_memory(const small_vector& other, bool propagate) const noexcept
+		{
+			return propagate || std::allocator_traits<allocator_type>::is_always_equal::value || m_allocator == other.m_allocator;
+		}
 
 		constexpr bool using_heap() const noexcept
 		{
@@ -443,7 +459,7 @@ namespace utils
 			}
 			else
 			{
-				std::memset(memory.start, reinterpret_cast<int>(value), memory.size());
+				std::memset(memory.start, std::bit_cast<unsigned char>(value), memory.size());
 			}
 		}
 
@@ -454,9 +470,12 @@ namespace utils
 			{
 				memset_buffer(memory, value);
 			}
-			for (T* it = memory.start; it != memory.finish; ++it)
+			else
 			{
-				op(it, value);
+				for (T* it = memory.start; it != memory.finish; ++it)
+				{
+					op(it, value);
+				}
 			}
 		}
 
@@ -474,17 +493,20 @@ namespace utils
 		{
 			if constexpr (can_fill_with_memset())
 			{
-				memset_buffer(memory.get_unified_memory(), value);
+				memset_buffer(memory.get_unified_buffer(), value);
+			}
+			else
+			{
+				fill_initialised_memory(memory.initialised_memory, value);
+				fill_raw_memory(memory.uninitialised_memory, value);
 			}
-			fill_initialised_memory(memory.initialised_memory, value);
-			fill_raw_memory(memory.uninitialised_memory, value);
 		}
 	};
 }
 
 template <typename T, std::size_t STACK_SIZE, typename ALLOC>
 inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>::small_vector(const allocator_type& alloc) noexcept
-	: m_num_elements{ 0 }, m_capacity{ stack_buffer_size() }{}
+	: m_num_elements{ 0 }, m_capacity{ stack_buffer_size() }, m_allocator{ alloc }{}
 
 template <typename T, std::size_t STACK_SIZE, typename ALLOC>
 inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>::small_vector(size_type count, const allocator_type& alloc)
@@ -493,7 +515,7 @@ inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>::small_vector(size_ty
 template<typename T, std::size_t STACK_SIZE, typename ALLOC>
 inline constexpr typename utils::small_vector<T, STACK_SIZE, ALLOC>::size_type utils::small_vector<T, STACK_SIZE, ALLOC>::max_size() const noexcept
 {
-	return std::allocator_traits<ALLOC>::max_size(ALLOC());
+	return std::allocator_traits<ALLOC>::max_size(m_allocator);
 }
 
 template<typename T, std::size_t STACK_SIZE, typename ALLOC>
@@ -513,7 +535,7 @@ inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>::small_vector(InputIt
 
 template<typename T, std::size_t STACK_SIZE, typename ALLOC>
 inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>::small_vector(const small_vector<T, STACK_SIZE, ALLOC>& other)
-	: small_vector(other,allocator_type())
+	: small_vector(other,std::allocator_traits<ALLOC>::select_on_container_copy_construction(other.get_allocator()))
 {
 }
 
@@ -525,7 +547,7 @@ inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>::small_vector(const s
 
 template<typename T, std::size_t STACK_SIZE, typename ALLOC>
 inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>::small_vector(small_vector<T, STACK_SIZE, ALLOC>&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
-	: small_vector(std::forward<small_vector<T,STACK_SIZE,ALLOC>>(other),allocator_type())
+	: small_vector(std::forward<small_vector<T,STACK_SIZE,ALLOC>>(other),other.get_allocator())
 {
 }
 
@@ -682,10 +704,15 @@ inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>& utils::small_vector<
 	{
 		return *this;
 	}
-	if (other.using_heap())
+	constexpr bool propagate = std::allocator_traits<ALLOC>::propagate_on_container_move_assignment::value;
+	if (other.using_heap() && can_take_heap_memory(other, propagate))
 	{
 		clear();
 		shrink_to_fit();
+		if constexpr (propagate)
+		{
+			m_allocator = other.m_allocator;
+		}
 		m_data.heap_data = other.m_data.heap_data;
 		m_capacity = other.capacity();
 		m_num_elements = other.size();
@@ -693,8 +720,10 @@ inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>& utils::small_vector<
 		other.m_num_elements = 0;
 		return *this;
 	}
-	
-	AdventCheck(capacity() >= other.size());
+
+	// Elements are moved one by one when other's memory came from an allocator that can't free it
+	// here, as well as when it is on the stack.
+	reserve(other.size());
 	if constexpr (std::is_trivially_copy_assignable_v<T>)
 	{
 		std::memcpy(begin(), other.begin(), sizeof(T) * other.size());
@@ -893,14 +922,21 @@ inline constexpr void utils::small_vector<T, STACK_SIZE, ALLOC>::resize(size_typ
 template<typename T, std::size_t STACK_SIZE, typename ALLOC>
 inline constexpr void utils::small_vector<T, STACK_SIZE, ALLOC>::swap(small_vector& other) noexcept
 {
-	if (using_heap() && other.using_heap())
+	constexpr bool propagate = std::allocator_traits<ALLOC>::propagate_on_container_swap::value;
+	if (using_heap() && other.using_heap() && can_take_heap_memory(other, propagate))
 	{
 		std::swap(m_data.heap_data, other.m_data.heap_data);
+		std::swap(m_num_elements, other.m_num_elements);
+		std::swap(m_capacity, other.m_capacity);
+		if constexpr (propagate)
+		{
+			std::swap(m_allocator, other.m_allocator);
+		}
 	}
 	else
 	{
 		small_vector<T, STACK_SIZE, ALLOC> temp = std::move(other);
-		other = std::move(this);
+		other = std::move(*this);
 		*this = std::move(temp);
 	}
 }
@@ -9,21 +9,23 @@
 
 namespace utils
 {
-	template <typename T, typename BinaryPred = std::less<T>, std::size_t BufferSize = 1>
+	template <typename T, typename BinaryPred = std::less<T>, std::size_t BufferSize = 1, typename ALLOC = std::allocator<T>>
 	class sorted_vector
 	{
 	public:
-		using iterator = typename utils::small_vector<T,BufferSize>::iterator;
-		using const_iterator = typename utils::small_vector<T,BufferSize>::const_iterator;
+		using iterator = typename utils::small_vector<T,BufferSize,ALLOC>::iterator;
+		using const_iterator = typename utils::small_vector<T,BufferSize,ALLOC>::const_iterator;
 		using value_type = T;
+		using allocator_type = ALLOC;
 	protected:
-		mutable utils::small_vector<T,BufferSize> m_data;
+		mutable utils::small_vector<T,BufferSize,ALLOC> m_data;
 		BinaryPred m_compare;
 		mutable bool m_sorted;
 	public:
 		sorted_vector() : sorted_vector(BinaryPred{}) {}
-		explicit sorted_vector(const BinaryPred& compare)
-			: m_data()
+		explicit sorted_vector(const allocator_type& alloc) : sorted_vector(BinaryPred{}, alloc) {}
+		explicit sorted_vector(const BinaryPred& compare, const allocator_type& alloc = allocator_type{})
+			: m_data(alloc)
 			, m_compare(compare)
 			, m_sorted(true)
 		{
@@ -33,8 +35,8 @@ namespace utils
 		sorted_vector(InputIt start, InputIt finish) : sorted_vector(start, finish, BinaryPred{}) {}
 
 		template <typename InputIt>
-		sorted_vector(InputIt start, InputIt finish, BinaryPred compare)
-			: m_data(start, finish)
+		sorted_vector(InputIt start, InputIt finish, BinaryPred compare, const allocator_type& alloc = allocator_type{})
+			: m_data(start, finish, alloc)
 			, m_compare(compare)
 			, m_sorted(false)
 		{}
@@ -49,6 +51,11 @@ namespace utils
 		sorted_vector& operator=(const sorted_vector&) = default;
 		sorted_vector& operator=(sorted_vector&&) = default;
 
+		allocator_type get_allocator() const noexcept
+		{
+			return m_data.get_allocator();
+		}
+
 		void reserve(std::size_t new_capacity)
 		{
 			m_data.reserve(new_capacity);
@@ -625,38 +632,38 @@ namespace utils
 	};
 }
 
-template <typename T, typename BinaryPred>
-inline auto begin(utils::sorted_vector<T,BinaryPred>& sv) { return sv.begin(); }
+template <typename T, typename BinaryPred, std::size_t BufferSize, typename ALLOC>
+inline auto begin(utils::sorted_vector<T,BinaryPred,BufferSize,ALLOC>& sv) { return sv.begin(); }
 
-template <typename T, typename BinaryPred>
-inline auto begin(const utils::sorted_vector<T,BinaryPred>& sv) { return sv.begin(); }
+template <typename T, typename BinaryPred, std::size_t BufferSize, typename ALLOC>
+inline auto begin(const utils::sorted_vector<T,BinaryPred,BufferSize,ALLOC>& sv) { return sv.begin(); }
 
-template <typename T, typename BinaryPred>
-inline auto end(utils::sorted_vector<T,BinaryPred>& sv) { return sv.end(); }
+template <typename T, typename BinaryPred, std::size_t BufferSize, typename ALLOC>
+inline auto end(utils::sorted_vector<T,BinaryPred,BufferSize,ALLOC>& sv) { return sv.end(); }
 
-template <typename T, typename BinaryPred>
-inline auto end(const utils::sorted_vector<T,BinaryPred>& sv) { return sv.end(); }
+template <typename T, typename BinaryPred, std::size_t BufferSize, typename ALLOC>
+inline auto end(const utils::sorted_vector<T,BinaryPred,BufferSize,ALLOC>& sv) { return sv.end(); }
 
-template <typename T, typename BinaryPred>
-inline auto rbegin(utils::sorted_vector<T,BinaryPred>& sv) { return sv.rbegin(); }
+template <typename T, typename BinaryPred, std::size_t BufferSize, typename ALLOC>
+inline auto rbegin(utils::sorted_vector<T,BinaryPred,BufferSize,ALLOC>& sv) { return sv.rbegin(); }
 
-template <typename T, typename BinaryPred>
-inline auto rbegin(const utils::sorted_vector<T,BinaryPred>& sv) { return sv.rbegin(); }
+template <typename T, typename BinaryPred, std::size_t BufferSize, typename ALLOC>
+inline auto rbegin(const utils::sorted_vector<T,BinaryPred,BufferSize,ALLOC>& sv) { return sv.rbegin(); }
 
-template <typename T, typename BinaryPred>
-inline auto rend(utils::sorted_vector<T,BinaryPred>& sv) { return sv.rend(); }
+template <typename T, typename BinaryPred, std::size_t BufferSize, typename ALLOC>
+inline auto rend(utils::sorted_vector<T,BinaryPred,BufferSize,ALLOC>& sv) { return sv.rend(); }
 
-template <typename T, typename BinaryPred>
-inline auto rend(const utils::sorted_vector<T,BinaryPred>& sv) { return sv.rend(); }
+template <typename T, typename BinaryPred, std::size_t BufferSize, typename ALLOC>
+inline auto rend(const utils::sorted_vector<T,BinaryPred,BufferSize,ALLOC>& sv) { return sv.rend(); }
 
-template <typename T, typename BinaryPred>
-inline auto cbegin(const utils::sorted_vector<T,BinaryPred>& sv) { return sv.cbegin(); }
+template <typename T, typename BinaryPred, std::size_t BufferSize, typename ALLOC>
+inline auto cbegin(const utils::sorted_vector<T,BinaryPred,BufferSize,ALLOC>& sv) { return sv.cbegin(); }
 
-template <typename T, typename BinaryPred>
-inline auto cend(const utils::sorted_vector<T,BinaryPred>& sv) { return sv.cend(); }
+template <typename T, typename BinaryPred, std::size_t BufferSize, typename ALLOC>
+inline auto cend(const utils::sorted_vector<T,BinaryPred,BufferSize,ALLOC>& sv) { return sv.cend(); }
 
-template <typename T, typename BinaryPred>
-inline auto crbegin(const utils::sorted_vector<T,BinaryPred>& sv) { return sv.crbegin(); }
+template <typename T, typename BinaryPred, std::size_t BufferSize, typename ALLOC>
+inline auto crbegin(const utils::sorted_vector<T,BinaryPred,BufferSize,ALLOC>& sv) { return sv.crbegin(); }
 
-template <typename T, typename BinaryPred>
-inline auto crend(const utils::sorted_vector<T,BinaryPred>& sv) { return sv.crend(); }
\ No newline at end of file
+template <typename T, typename BinaryPred, std::size_t BufferSize, typename ALLOC>
+inline auto crend(const utils::sorted_vector<T,BinaryPred,BufferSize,ALLOC>& sv) { return sv.crend(); }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <vector>
 #include <numeric>
 #include <array>
+#include <memory>
 
 namespace utils
 {
@@ -57,9 +58,11 @@ namespace utils
 		return split_string_at_last(str, std::string_view(&delim, 1));
 	}
 
-	[[nodiscard]] inline std::vector<std::string_view> split_string(std::string_view str, std::string_view delim)
+	// Pass an allocator to put the pieces somewhere other than the heap, such as a scratch_scope.
+	template <typename Alloc = std::allocator<std::string_view>>
+	[[nodiscard]] inline std::vector<std::string_view, Alloc> split_string(std::string_view str, std::string_view delim, const Alloc& alloc = Alloc{})
 	{
-		std::vector<std::string_view> result;
+		std::vector<std::string_view, Alloc> result(alloc);
 		std::string_view split_state = str;
 		while (!split_state.empty())
 		{
@@ -70,9 +73,10 @@ namespace utils
 		return result;
 	}
 
-	[[nodiscard]] inline std::vector<std::string_view> split_string(std::string_view str, char delim)
+	template <typename Alloc = std::allocator<std::string_view>>
+	[[nodiscard]] inline std::vector<std::string_view, Alloc> split_string(std::string_view str, char delim, const Alloc& alloc = Alloc{})
 	{
-		return split_string(str, std::string_view{ &delim,1 });
+		return split_string(str, std::string_view{ &delim,1 }, alloc);
 	}
 
 	[[nodiscard]] inline std::vector<std::string_view> split_string(std::string_view str)
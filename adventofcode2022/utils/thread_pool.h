@@ -0,0 +1,223 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace utils
+{
+	// The most threads that parallel work keeps busy at once, counting the thread that starts it.
+	// Defaults to one per hardware thread. The global pool is built to match the first time it is
+	// used, so set this before any parallel work starts; setting it afterwards is an error.
+	void set_thread_count(std::size_t num_threads);
+	std::size_t get_thread_count();
+
+	// Runs tasks on a fixed set of worker threads. Each worker has its own queue: tasks a worker
+	// submits go on the back of that queue and it takes them from the back, so nested work stays
+	// in cache, while idle workers steal from the front of the others' queues. Tasks submitted from
+	// outside the pool go on a shared queue and start in the order they were submitted.
+	class thread_pool
+	{
+		using task = std::function<void()>;
+		struct task_queue
+		{
+			std::mutex lock;
+			std::deque<task> tasks;
+		};
+
+		std::vector<std::unique_ptr<task_queue>> m_worker_queues;
+		task_queue m_shared_queue;
+		std::vector<std::thread> m_workers;
+
+		std::mutex m_sleep_lock;
+		std::condition_variable m_wake;
+		std::atomic<std::size_t> m_num_queued{ 0 };
+		bool m_stopping = false;
+
+		std::optional<task> take_task(std::size_t worker_id);
+		void worker_loop(std::size_t worker_id);
+	public:
+		explicit thread_pool(std::size_t num_workers);
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator=(const thread_pool&) = delete;
+
+		// Runs any tasks still queued, then joins the workers.
+		~thread_pool();
+
+		// Tasks must not throw; use task_group to get exceptions back.
+		// With no workers the task runs straight away on the calling thread.
+		void submit(task new_task);
+		std::size_t num_workers() const noexcept { return m_workers.size(); }
+
+		// The shared pool, with one worker fewer than get_thread_count() since whichever thread
+		// waits on the work helps with it.
+		static thread_pool& global();
+	};
+
+	// Tasks that are waited on together. wait() runs any of the group's tasks the pool hasn't
+	// started yet on the waiting thread, so a group never needs a free worker to finish, and groups
+	// nested inside each other's tasks can't deadlock. The first exception a task throws is
+	// rethrown from wait() once every task has finished; any later ones are dropped.
+	class task_group
+	{
+		struct shared_state
+		{
+			std::mutex lock;
+			std::condition_variable finished;
+			std::deque<std::function<void()>> pending;
+			std::size_t num_running = 0;
+			std::exception_ptr error;
+
+			// Runs the oldest pending task, if there is one.
+			bool run_one();
+		};
+
+		thread_pool& m_pool;
+		std::shared_ptr<shared_state> m_state;
+	public:
+		explicit task_group(thread_pool& pool = thread_pool::global());
+		task_group(const task_group&) = delete;
+		task_group& operator=(const task_group&) = delete;
+
+		// Waits for the tasks, dropping any exception, so captured references stay valid.
+		~task_group();
+
+		void run(std::function<void()> new_task);
+		void wait();
+	};
+
+	namespace thread_pool_internal
+	{
+		// A few chunks per thread evens out chunks that take different amounts of time.
+		constexpr std::size_t chunks_per_thread = 4;
+
+		inline std::size_t get_num_chunks(std::size_t count, std::size_t grain_size)
+		{
+			const std::size_t num_threads = thread_pool::global().num_workers() + 1;
+			const std::size_t max_chunks = (count + std::max<std::size_t>(grain_size, 1) - 1) / std::max<std::size_t>(grain_size, 1);
+			return std::min(max_chunks, num_threads * chunks_per_thread);
+		}
+
+		// Calls func(chunk_index, offset_first, offset_last) for each of num_chunks even slices of
+		// [0, count), spread over the global pool and the calling thread.
+		template <typename Func>
+		void for_each_chunk(std::size_t count, std::size_t num_chunks, Func& func)
+		{
+			auto get_offset = [count, num_chunks](std::size_t chunk) { return count * chunk / num_chunks; };
+			if (num_chunks <= 1)
+			{
+				func(std::size_t{ 0 }, std::size_t{ 0 }, count);
+				return;
+			}
+
+			std::atomic<std::size_t> next_chunk{ 0 };
+			auto run_chunks = [&]()
+			{
+				try
+				{
+					for (std::size_t chunk = next_chunk++; chunk < num_chunks; chunk = next_chunk++)
+					{
+						func(chunk, get_offset(chunk), get_offset(chunk + 1));
+					}
+				}
+				catch (...)
+				{
+					// No point starting more chunks once one has failed.
+					next_chunk = num_chunks;
+					throw;
+				}
+			};
+
+			task_group group;
+			const std::size_t num_helpers = std::min(thread_pool::global().num_workers(), num_chunks - 1);
+			for (std::size_t i = 0; i < num_helpers; ++i)
+			{
+				group.run(run_chunks);
+			}
+			try
+			{
+				run_chunks();
+			}
+			catch (...)
+			{
+				group.wait();
+				throw;
+			}
+			group.wait();
+		}
+	}
+
+	// Calls func(i) for every i in [first, last). The range is cut into chunks of at least
+	// grain_size indices, which the pool's threads and the calling thread work through between them.
+	template <typename IndexType, typename Func>
+	void parallel_for(IndexType first, IndexType last, Func func, std::size_t grain_size = 1)
+	{
+		if (!(first < last)) return;
+		const auto count = static_cast<std::size_t>(last - first);
+		auto run_chunk = [first, &func](std::size_t, std::size_t offset_first, std::size_t offset_last)
+		{
+			for (std::size_t offset = offset_first; offset < offset_last; ++offset)
+			{
+				func(static_cast<IndexType>(first + static_cast<IndexType>(offset)));
+			}
+		};
+		thread_pool_internal::for_each_chunk(count, thread_pool_internal::get_num_chunks(count, grain_size), run_chunk);
+	}
+
+	// As parallel_for, but calls func(range_first, range_last) once per chunk, for work that wants
+	// to set something up once per chunk rather than once per index.
+	template <typename IndexType, typename Func>
+	void parallel_for_ranges(IndexType first, IndexType last, Func func, std::size_t grain_size = 1)
+	{
+		if (!(first < last)) return;
+		const auto count = static_cast<std::size_t>(last - first);
+		auto run_chunk = [first, &func](std::size_t, std::size_t offset_first, std::size_t offset_last)
+		{
+			func(static_cast<IndexType>(first + static_cast<IndexType>(offset_first)),
+				static_cast<IndexType>(first + static_cast<IndexType>(offset_last)));
+		};
+		thread_pool_internal::for_each_chunk(count, thread_pool_internal::get_num_chunks(count, grain_size), run_chunk);
+	}
+
+	// Combines transform(i) for every i in [first, last) with reduce, starting from init.
+	// reduce must be associative. Chunks are combined in index order, so the result is the same
+	// for any number of threads.
+	template <typename IndexType, typename T, typename ReduceFunc, typename TransformFunc>
+	T parallel_reduce(IndexType first, IndexType last, T init, ReduceFunc reduce, TransformFunc transform, std::size_t grain_size = 1)
+	{
+		if (!(first < last)) return init;
+		const auto count = static_cast<std::size_t>(last - first);
+		const std::size_t num_chunks = thread_pool_internal::get_num_chunks(count, grain_size);
+		std::vector<std::optional<T>> partial_results(num_chunks);
+		auto run_chunk = [first, &reduce, &transform, &partial_results](std::size_t chunk, std::size_t offset_first, std::size_t offset_last)
+		{
+			auto get_value = [first, &transform](std::size_t offset)
+			{
+				return transform(static_cast<IndexType>(first + static_cast<IndexType>(offset)));
+			};
+			T partial = get_value(offset_first);
+			for (std::size_t offset = offset_first + 1; offset < offset_last; ++offset)
+			{
+				partial = reduce(std::move(partial), get_value(offset));
+			}
+			partial_results[chunk] = std::move(partial);
+		};
+		thread_pool_internal::for_each_chunk(count, num_chunks, run_chunk);
+
+		T result = std::move(init);
+		for (std::optional<T>& partial : partial_results)
+		{
+			result = reduce(std::move(result), std::move(partial.value()));
+		}
+		return result;
+	}
+}
\ No newline at end of file